@@ -37,15 +37,23 @@
 #include "bus/client/SettingService.h"
 #include "bus/client/WAM.h"
 #include "bus/service/ApplicationManager.h"
+#include "conf/LaunchPointStore.h"
 #include "conf/RuntimeInfo.h"
 #include "conf/SAMConf.h"
+#include "manager/MemoryPolicy.h"
+#include "manager/Prewarmer.h"
+#include "manager/ResourceMonitor.h"
 #include "util/File.h"
 #include "util/JValueUtil.h"
+#include "util/OutputCapture.h"
+#include "util/ProcessTracker.h"
 
 
 MainDaemon::MainDaemon()
     : m_isCBDGenerated(false),
-      m_isConfigsReceived(false)
+      m_isConfigsReceived(false),
+      m_isAttached(false),
+      m_isCatalogLoaded(false)
 {
     setClassName("MainDaemon");
     m_mainLoop = g_main_loop_new(NULL, FALSE);
@@ -62,24 +70,36 @@ void MainDaemon::initialize()
 {
     RuntimeInfo::getInstance().initialize();
     SAMConf::getInstance().initialize();
-    AppDescriptionList::getInstance().scanFull();
+    ProcessTracker::getInstance().initialize();
+
+    // Service is attached as soon as critical apps are scanned
+    AppDescriptionList::getInstance().EventScanStageChanged.connect(boost::bind(&MainDaemon::onScanStageChanged, this, boost::placeholders::_1));
+    AppDescriptionList::getInstance().scanStaged();
 
     if (!ApplicationManager::getInstance().attach(m_mainLoop))
         return;
+    m_isAttached = true;
 
     AppInstallService::getInstance().initialize();
     Bootd::getInstance().initialize();
     Configd::getInstance().initialize();
-    DB8::getInstance().initialize();
     LSM::getInstance().initialize();
     MemoryManager::getInstance().initialize();
     NativeContainer::getInstance().initialize();
     Notification::getInstance().initialize();
     SettingService::getInstance().initialize();
     WAM::getInstance().initialize();
+    ResourceMonitor::getInstance().initialize();
+    MemoryPolicy::getInstance().initialize();
+    Prewarmer::getInstance().initialize();
 
     Bootd::getInstance().EventGetBootStatus.connect(boost::bind(&MainDaemon::onGetBootStatus, this, boost::placeholders::_1));
     Configd::getInstance().EventGetConfigs.connect(boost::bind(&MainDaemon::onGetConfigs, this, boost::placeholders::_1));
+
+    if (AppDescriptionList::getInstance().getScanStage() == ScanStage::ScanStage_Full) {
+        loadLaunchPoints();
+        NativeContainer::getInstance().reloadRunningApps();
+    }
 }
 
 void MainDaemon::finalize()
@@ -93,8 +113,15 @@ void MainDaemon::finalize()
     Notification::getInstance().finalize();
     SettingService::getInstance().finalize();
     WAM::getInstance().finalize();
+    ResourceMonitor::getInstance().finalize();
+    MemoryPolicy::getInstance().finalize();
+    Prewarmer::getInstance().finalize();
 
     ApplicationManager::getInstance().detach();
+    OutputCapture::getInstance().finalize();
+    ProcessTracker::getInstance().finalize();
+    LaunchPointStore::getInstance().finalize();
+    SAMConf::getInstance().finalize();
 }
 
 void MainDaemon::start()
@@ -109,6 +136,32 @@ void MainDaemon::stop()
         g_main_loop_quit(m_mainLoop);
 }
 
+void MainDaemon::onScanStageChanged(ScanStage stage)
+{
+    // Stages reached before attach are handled in initialize()
+    if (!m_isAttached)
+        return;
+
+    ApplicationManager::getInstance().postGetCatalogStatus();
+    if (stage == ScanStage::ScanStage_Full) {
+        loadLaunchPoints();
+        NativeContainer::getInstance().reloadRunningApps();
+        ApplicationManager::getInstance().resumeStreams();
+        checkPreconditions();
+    }
+}
+
+void MainDaemon::loadLaunchPoints()
+{
+    // Launch points are restored only for known apps. Wait for whole catalog.
+    if (m_isCatalogLoaded)
+        return;
+    m_isCatalogLoaded = true;
+
+    LaunchPointStore::getInstance().initialize();
+    DB8::getInstance().initialize();
+}
+
 void MainDaemon::onGetBootStatus(const JValue& subscriptionPayload)
 {
     bool coreBootDone;
@@ -149,9 +202,15 @@ void MainDaemon::checkPreconditions()
         Logger::info(getClassName(), __FUNCTION__, "Wait for receiving 'getBootStatus' response");
         return;
     }
+    // listApps and listLaunchPoints should not reply partial catalog
+    if (AppDescriptionList::getInstance().getScanStage() != ScanStage::ScanStage_Full) {
+        Logger::info(getClassName(), __FUNCTION__, "Wait for scanning whole catalog");
+        return;
+    }
     Logger::info(getClassName(), __FUNCTION__, "All initial components are ready");
     isFired = true;
 
     ApplicationManager::getInstance().enablePosting();
+    ApplicationManager::getInstance().postGetCatalogStatus();
 }
 
@@ -19,6 +19,7 @@
 
 #include <luna-service2/lunaservice.h>
 
+#include "base/AppDescriptionList.h"
 #include "base/LunaTask.h"
 #include "interface/ISingleton.h"
 #include "interface/IClassName.h"
@@ -40,11 +41,15 @@ private:
 
     void onGetBootStatus(const JValue& subscriptionPayload);
     void onGetConfigs(const JValue& subscriptionPayload);
+    void onScanStageChanged(ScanStage stage);
 
     void checkPreconditions();
+    void loadLaunchPoints();
 
     bool m_isCBDGenerated;
     bool m_isConfigsReceived;
+    bool m_isAttached;
+    bool m_isCatalogLoaded;
 
     GMainLoop *m_mainLoop;
 
@@ -25,6 +25,7 @@
 #include "base/AppDescription.h"
 #include "bus/client/SettingService.h"
 #include "conf/SAMConf.h"
+#include "util/DirectoryCache.h"
 #include "util/JValueUtil.h"
 #include "util/File.h"
 
@@ -164,6 +165,22 @@ AppLocation AppDescription::toAppLocation(const string& type)
     }
 }
 
+// Collects 'language', 'language/script' and 'language/script/region' dirs which have appinfo.json
+static void findLocaleDirs(const string& root, const string& relative, int depth, set<string>& dirs)
+{
+    vector<string> children;
+    if (!DirectoryCache::getInstance().getDirectories(relative.empty() ? root : root + "/" + relative, children))
+        return;
+
+    for (const string& name : children) {
+        string child = relative.empty() ? name : relative + "/" + name;
+        if (DirectoryCache::getInstance().isFile(root + "/" + child + "/appinfo.json"))
+            dirs.insert(child);
+        if (depth < 2)
+            findLocaleDirs(root, child, depth + 1, dirs);
+    }
+}
+
 AppDescription::AppDescription(const string& appId)
     : m_appLocation(AppLocation::AppLocation_None),
       m_folderPath(""),
@@ -173,7 +190,8 @@ AppDescription::AppDescription(const string& appId)
       m_absMain(""),
       m_absSplashBackground(""),
       m_isLocked(false),
-      m_isScanned(false)
+      m_isScanned(false),
+      m_revision(0)
 {
 }
 
@@ -184,12 +202,15 @@ AppDescription::~AppDescription()
 bool AppDescription::scan()
 {
     m_isScanned = false;
+    m_revision++;
+    m_jsonString.clear();
+    m_jsonStrings.clear();
     if (m_appId.empty() || m_folderPath.empty() || m_appLocation == AppLocation::AppLocation_None) {
         Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, "Required members are not set");
         return false;
     }
 
-    if (!File::isDirectory(m_folderPath)) {
+    if (!DirectoryCache::getInstance().isDirectory(m_folderPath)) {
         Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, "FolderPath is not exist");
         return false;
     }
@@ -260,6 +281,47 @@ JValue AppDescription::getJson(JValue& properties)
     return result;
 }
 
+const string& AppDescription::getJsonString()
+{
+    if (m_jsonString.empty())
+        m_jsonString = m_appinfo.stringify();
+    return m_jsonString;
+}
+
+string AppDescription::getJsonString(JValue& properties)
+{
+    if (!properties.isArray() || properties.arraySize() == 0)
+        return getJsonString();
+
+    set<string> names;
+    for (int i = 0; i < properties.arraySize(); ++i) {
+        if (properties[i].isString())
+            names.insert(properties[i].asString());
+    }
+    if (names.empty())
+        return getJson(properties).stringify();
+
+    JValue normalized = pbnjson::Array();
+    string key;
+    for (const string& name : names) {
+        normalized.append(name);
+        key += name + "\n";
+    }
+
+    for (auto it = m_jsonStrings.begin(); it != m_jsonStrings.end(); ++it) {
+        if (it->first != key)
+            continue;
+        m_jsonStrings.splice(m_jsonStrings.begin(), m_jsonStrings, it);
+        return it->second;
+    }
+
+    // Clients can request any projection. Keep only recent ones.
+    m_jsonStrings.push_front(make_pair(key, getJson(normalized).stringify()));
+    if (m_jsonStrings.size() > MAX_JSON_STRINGS)
+        m_jsonStrings.pop_back();
+    return m_jsonStrings.front().second;
+}
+
 bool AppDescription::loadAppinfo()
 {
     // Specify application description depending on available locale string.
@@ -270,7 +332,7 @@ bool AppDescription::loadAppinfo()
     // or resources/<language>/<script>/<region>/appinfo.json respectively.
     // (Note that the script dir goes in between the language and region dirs.)
     const string appinfoPath = File::join(m_folderPath, "/appinfo.json");
-    m_appinfo = JDomParser::fromFile(appinfoPath.c_str(), JValueUtil::getSchema("ApplicationDescription"));
+    m_appinfo = JValueUtil::parseMappedFile(appinfoPath, JValueUtil::getSchema("ApplicationDescription"));
     if (!isValidAppInfo(m_appinfo)) {
         Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, Logger::format("Failed to parse appinfo.json(%s)", appinfoPath.c_str()));
         m_appinfo = pbnjson::JValue();
@@ -280,69 +342,110 @@ bool AppDescription::loadAppinfo()
     /// Add folderPath to JSON
     m_appinfo.put("folderPath", m_folderPath);
 
-    vector<string> localizationDirs;
-    string resourcePath = m_folderPath + "/resources/" + SAMConf::getInstance().getLanguage() + "/";
-    localizationDirs.push_back(resourcePath);
+    // Index overlays once. Locale changes only revisit apps which have them.
+    m_localeDirs.clear();
+    findLocaleDirs(File::join(m_folderPath, "resources"), "", 0, m_localeDirs);
+    m_baseAppinfo = m_localeDirs.empty() ? pbnjson::JValue() : m_appinfo.duplicate();
+
+    m_appliedLocaleDirs.clear();
+    vector<string> localeDirs;
+    getLocaleDirs(localeDirs);
+    for (const auto& localeDir : localeDirs) {
+        JValue localeAppinfo = JValueUtil::parseMappedFile(getLocaleAppinfoPath(localeDir));
+        applyLocaleAppinfo(localeDir, localeAppinfo);
+    }
+    return true;
+}
 
-    resourcePath += SAMConf::getInstance().getScript() + "/";
-    localizationDirs.push_back(resourcePath);
+bool AppDescription::getLocaleDirs(vector<string>& dirs) const
+{
+    dirs.clear();
+    if (m_localeDirs.empty())
+        return false;
 
-    resourcePath += SAMConf::getInstance().getRegion() + "/";
-    localizationDirs.push_back(resourcePath);
+    // Script dir goes in between language and region dirs. Empty one is skipped.
+    string dir = SAMConf::getInstance().getLanguage();
+    const string components[] = { SAMConf::getInstance().getScript(), SAMConf::getInstance().getRegion() };
+    if (m_localeDirs.count(dir))
+        dirs.push_back(dir);
+    for (const auto& component : components) {
+        if (component.empty())
+            continue;
+        dir += "/" + component;
+        if (m_localeDirs.count(dir))
+            dirs.push_back(dir);
+    }
+    return dirs != m_appliedLocaleDirs;
+}
+
+string AppDescription::getLocaleAppinfoPath(const string& dir) const
+{
+    return m_folderPath + "/resources/" + dir + "/appinfo.json";
+}
 
+void AppDescription::applyLocale(const vector<string>& dirs, const vector<JValue>& localeAppinfos)
+{
+    m_revision++;
+    m_jsonString.clear();
+    m_jsonStrings.clear();
+    m_appinfo = m_baseAppinfo.duplicate();
+    m_appliedLocaleDirs.clear();
+
+    for (size_t i = 0; i < dirs.size() && i < localeAppinfos.size(); ++i) {
+        applyLocaleAppinfo(dirs[i], localeAppinfos[i]);
+    }
+    readAppinfo();
+    readAsset();
+}
+
+void AppDescription::applyLocaleAppinfo(const string& dir, const JValue& localeAppinfo)
+{
     // apply localization (overwrite from low to high)
-    for (const auto& localizationDir : localizationDirs) {
-        string AbsoluteLocaleAppinfoPath = localizationDir + "appinfo.json";
-        string RelativeLocaleAppinfoPath = localizationDir.substr(m_folderPath.length());
+    string AbsoluteLocaleAppinfoPath = getLocaleAppinfoPath(dir);
+    string RelativeLocaleAppinfoPath = "/resources/" + dir + "/";
+
+    m_appliedLocaleDirs.push_back(dir);
+    if (localeAppinfo.isNull()) {
+        Logger::info(CLASS_NAME, __FUNCTION__, "IGNORRED", Logger::format("failed_to_load_localication: %s", AbsoluteLocaleAppinfoPath.c_str()));
+        return;
+    }
+
+    for (auto item : localeAppinfo.children()) {
+        string key = item.first.asString();
 
-        if (!File::isFile(AbsoluteLocaleAppinfoPath)) {
+        if (!m_appinfo.hasKey(key) || m_appinfo[key].getType() != localeAppinfo[key].getType()) {
+            Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, AbsoluteLocaleAppinfoPath, "localization is unmatchted with root");
             continue;
         }
 
-        JValue localeAppinfo = JDomParser::fromFile(AbsoluteLocaleAppinfoPath.c_str());
-        if (localeAppinfo.isNull()) {
-            Logger::info(CLASS_NAME, __FUNCTION__, "IGNORRED", Logger::format("failed_to_load_localication: %s", localizationDir.c_str()));
+        if (m_appinfo[key] == localeAppinfo[key]) {
             continue;
         }
 
-        for (auto item : localeAppinfo.children()) {
-            string key = item.first.asString();
+        if (find(PROPS_PROHIBITED.begin(), PROPS_PROHIBITED.end(), key) != PROPS_PROHIBITED.end()) {
+            Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, AbsoluteLocaleAppinfoPath, "localization is prohibited_props");
+            continue;
+        }
 
-            if (!m_appinfo.hasKey(key) || m_appinfo[key].getType() != localeAppinfo[key].getType()) {
-                Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, AbsoluteLocaleAppinfoPath, "localization is unmatchted with root");
-                continue;
-            }
+        if (find(ASSETS_SUPPORTED.begin(), ASSETS_SUPPORTED.end(), key) != ASSETS_SUPPORTED.end()) {
+            // check asset variation rule with root value
+            string baseAssetValue = m_appinfo[key].asString();
+            string localeAssetValue = localeAppinfo[key].asString();
 
-            if (m_appinfo[key] == localeAppinfo[key]) {
+            // if assets variation rule is specified, dont support localization
+            if (baseAssetValue.length() > 0 && baseAssetValue[0] == '$')
                 continue;
-            }
-
-            if (find(PROPS_PROHIBITED.begin(), PROPS_PROHIBITED.end(), key) != PROPS_PROHIBITED.end()) {
-                Logger::warning(CLASS_NAME, __FUNCTION__, m_appId, AbsoluteLocaleAppinfoPath, "localization is prohibited_props");
+            if (localeAssetValue.length() > 0 && localeAssetValue[0] == '$')
                 continue;
-            }
-
-            if (find(ASSETS_SUPPORTED.begin(), ASSETS_SUPPORTED.end(), key) != ASSETS_SUPPORTED.end()) {
-                // check asset variation rule with root value
-                string baseAssetValue = m_appinfo[key].asString();
-                string localeAssetValue = localeAppinfo[key].asString();
-
-                // if assets variation rule is specified, dont support localization
-                if (baseAssetValue.length() > 0 && baseAssetValue[0] == '$')
-                    continue;
-                if (localeAssetValue.length() > 0 && localeAssetValue[0] == '$')
-                    continue;
-            }
+        }
 
-            auto it = find(PROPS_IMAGES.begin(), PROPS_IMAGES.end(), key);
-            if (it != PROPS_IMAGES.end()) {
-                m_appinfo.put(key, RelativeLocaleAppinfoPath + localeAppinfo[key].asString());
-            } else {
-                m_appinfo.put(key, localeAppinfo[key]);
-            }
+        auto it = find(PROPS_IMAGES.begin(), PROPS_IMAGES.end(), key);
+        if (it != PROPS_IMAGES.end()) {
+            m_appinfo.put(key, RelativeLocaleAppinfoPath + localeAppinfo[key].asString());
+        } else {
+            m_appinfo.put(key, localeAppinfo[key]);
         }
     }
-    return true;
 }
 
 bool AppDescription::readAppinfo()
@@ -421,7 +524,7 @@ bool AppDescription::readAsset()
             pathToCheck = m_folderPath + string("/") + assetPath;
             Logger::debug(CLASS_NAME, __FUNCTION__, Logger::format("patch_to_check: %s\n", pathToCheck.c_str()));
 
-            if (0 == access(pathToCheck.c_str(), F_OK)) {
+            if (DirectoryCache::getInstance().exists(pathToCheck)) {
                 m_appinfo.put(key, assetPath);
                 foundAsset = true;
                 break;
@@ -18,11 +18,14 @@
 #define BASE_APPDESCRIPTION_H_
 
 #include <list>
+#include <map>
 #include <memory>
 #include <pbnjson.hpp>
+#include <set>
 #include <stdint.h>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "conf/RuntimeInfo.h"
 #include "interface/IClassName.h"
@@ -81,6 +84,17 @@ public:
     bool scan(const string& folderPath, const AppLocation& appLocation);
     void applyFolderPath(string& path);
 
+    // Locale overlays are indexed by scan. Apps without them are not affected by locale.
+    bool isLocalized() const
+    {
+        return !m_localeDirs.empty();
+    }
+    // Returns false if overlays of current locale are same with applied ones
+    bool getLocaleDirs(vector<string>& dirs) const;
+    string getLocaleAppinfoPath(const string& dir) const;
+    // Reapplies parsed overlays on cached base appinfo without rescanning
+    void applyLocale(const vector<string>& dirs, const vector<JValue>& localeAppinfos);
+
     bool isLocked() const
     {
         return m_isLocked;
@@ -106,6 +120,17 @@ public:
         json = m_appinfo.duplicate();
     }
 
+    // Serialized appinfo is cached until next scan.
+    // Only a few recent projections are cached. Properties are compared as a sorted set.
+    const string& getJsonString();
+    string getJsonString(JValue& properties);
+
+    // Increased by every scan. Used to invalidate caches built from appinfo.
+    int getRevision() const
+    {
+        return m_revision;
+    }
+
     const string& getFolderPath() const
     {
         return m_folderPath;
@@ -289,11 +314,14 @@ private:
     static const vector<string> PROPS_IMAGES;
     static const vector<string> ASSETS_SUPPORTED;
     static const string CLASS_NAME;
+    // Projections cached per app
+    static const size_t MAX_JSON_STRINGS = 4;
 
     AppDescription& operator=(const AppDescription& appDesc) = delete;
     AppDescription(const AppDescription& appDesc) = delete;
 
     bool loadAppinfo();
+    void applyLocaleAppinfo(const string& dir, const JValue& localeAppinfo);
     bool readAppinfo();
     bool readAsset();
 
@@ -336,10 +364,20 @@ private:
     string m_absSplashBackground;
 
     JValue m_appinfo;
+    // appinfo before localization. Kept only if the app has locale overlays.
+    JValue m_baseAppinfo;
+    // Relative dirs under 'resources' which have appinfo.json
+    set<string> m_localeDirs;
+    vector<string> m_appliedLocaleDirs;
+
     // runtime values
     bool m_isLocked;
     bool m_isScanned;
 
+    int m_revision;
+    string m_jsonString;
+    // normalized projection => serialized appinfo. Most recently used first.
+    list<pair<string, string>> m_jsonStrings;
 };
 
 #endif // BASE_APPDESCRIPTION_H_
@@ -16,10 +16,15 @@
 
 #include "base/AppDescriptionList.h"
 
+#include <climits>
+#include <malloc.h>
+
 #include "base/LaunchPointList.h"
 #include "bus/service/ApplicationManager.h"
 #include "conf/SAMConf.h"
+#include "util/DirectoryCache.h"
 #include "util/File.h"
+#include "util/Time.h"
 
 bool AppDescriptionList::compare(AppDescriptionPtr me, AppDescriptionPtr another)
 {
@@ -54,23 +59,91 @@ bool AppDescriptionList::compare(AppDescriptionPtr me, AppDescriptionPtr another
 }
 
 AppDescriptionList::AppDescriptionList()
+    : m_generation(0),
+      m_scanStage(ScanStage::ScanStage_None),
+      m_scanSourceId(0),
+      m_scanStartTime(0),
+      m_scanStartHeap(0)
 {
     setClassName("AppDescriptionList");
 }
 
 AppDescriptionList::~AppDescriptionList()
 {
+    if (m_scanSourceId != 0) {
+        g_source_remove(m_scanSourceId);
+        m_scanSourceId = 0;
+    }
+}
+
+static const int MAX_LOCALE_WORKERS = 4;
+
+gpointer AppDescriptionList::onParseLocaleJobs(gpointer data)
+{
+    // Workers only parse files. Logging and appinfo changes are done in main thread.
+    LocaleJobQueue* queue = static_cast<LocaleJobQueue*>(data);
+    while (true) {
+        int index = g_atomic_int_add(&queue->next, 1);
+        if (index >= (int) queue->jobs->size())
+            break;
+
+        LocaleJob& job = (*queue->jobs)[index];
+        for (const string& path : job.paths) {
+            job.localeAppinfos.push_back(JValueUtil::parseMappedFile(path));
+        }
+    }
+    return NULL;
 }
 
 void AppDescriptionList::changeLocale()
 {
-    for (auto appDesc : m_map) {
-        appDesc.second->scan();
+    // Titles are localized. Apps without overlays keep their appinfo and cached strings.
+    vector<LocaleJob> jobs;
+    for (auto it = m_map.begin(); it != m_map.end(); ++it) {
+        if (!it->second->isLocalized())
+            continue;
+
+        LocaleJob job;
+        if (!it->second->getLocaleDirs(job.dirs))
+            continue;
+        job.appDesc = it->second;
+        for (const string& dir : job.dirs) {
+            job.paths.push_back(it->second->getLocaleAppinfoPath(dir));
+        }
+        jobs.push_back(job);
     }
+
+    if (jobs.empty()) {
+        Logger::info(getClassName(), __FUNCTION__, "No app is affected by locale");
+        return;
+    }
+
+    LocaleJobQueue queue = { &jobs, 0 };
+    int workerCount = min((int) jobs.size(), min((int) g_get_num_processors(), MAX_LOCALE_WORKERS));
+    vector<GThread*> workers;
+    for (int i = 1; i < workerCount; ++i) {
+        workers.push_back(g_thread_new("LocaleParser", onParseLocaleJobs, &queue));
+    }
+    onParseLocaleJobs(&queue);
+    for (GThread* worker : workers) {
+        g_thread_join(worker);
+    }
+
+    for (LocaleJob& job : jobs) {
+        job.appDesc->applyLocale(job.dirs, job.localeAppinfos);
+        m_searchIndex.remove(job.appDesc->getAppId());
+        m_searchIndex.add(job.appDesc);
+    }
+    m_generation++;
+
+    Logger::info(getClassName(), __FUNCTION__,
+                 Logger::format("Localized apps(%d) workers(%d)", (int) jobs.size(), workerCount));
+    ApplicationManager::getInstance().postListApps(nullptr, "", "");
 }
 
 void AppDescriptionList::scanApp(const string& appId)
 {
+    DirectoryCache::getInstance().revalidate();
     AppDescriptionPtr newAppDesc = AppDescriptionList::getInstance().create(appId);
     if (newAppDesc == nullptr) {
         Logger::warning(getInstance().getClassName(), __FUNCTION__, appId, "Failed to create new AppDescription");
@@ -115,8 +188,151 @@ void AppDescriptionList::scanApp(const string& appId)
     AppDescriptionList::getInstance().add(newAppDesc);
 }
 
+// Bytes allocated by malloc and not freed yet
+static size_t getHeapUsage()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return (size_t) (unsigned int) mallinfo().uordblks;
+#endif
+}
+
+const char* AppDescriptionList::toString(ScanStage stage)
+{
+    switch (stage) {
+    case ScanStage::ScanStage_Critical:
+        return "critical";
+
+    case ScanStage::ScanStage_Full:
+        return "full";
+
+    default:
+        break;
+    }
+    return "none";
+}
+
+gboolean AppDescriptionList::onScanPending(gpointer context)
+{
+    AppDescriptionList& self = AppDescriptionList::getInstance();
+
+    int appsPerIdle = 0;
+    JValueUtil::getValue(SAMConf::getInstance().getStagedBoot(), "appsPerIdle", appsPerIdle);
+    if (appsPerIdle <= 0)
+        appsPerIdle = 1;
+
+    for (int i = 0; i < appsPerIdle && !self.m_pendingScans.empty(); ++i) {
+        ScanEntry entry = self.m_pendingScans.front();
+        // Entries of an app are indexed in list order. The front one is the first.
+        auto index = self.m_pendingScanIndex.find(entry.appId);
+        if (index != self.m_pendingScanIndex.end()) {
+            index->second.erase(index->second.begin());
+            if (index->second.empty())
+                self.m_pendingScanIndex.erase(index);
+        }
+        self.m_pendingScans.pop_front();
+        self.scanEntry(entry);
+    }
+    if (!self.m_pendingScans.empty())
+        return G_SOURCE_CONTINUE;
+
+    self.m_scanSourceId = 0;
+    self.logScanBenchmark();
+    self.setScanStage(ScanStage::ScanStage_Full);
+    return G_SOURCE_REMOVE;
+}
+
 void AppDescriptionList::scanFull()
 {
+    m_scanStartTime = Time::getCurrentTime();
+    m_scanStartHeap = getHeapUsage();
+
+    list<ScanEntry> entries;
+    collectScanEntries(entries);
+    for (const ScanEntry& entry : entries) {
+        scanEntry(entry);
+    }
+
+    logScanBenchmark();
+    setScanStage(ScanStage::ScanStage_Full);
+}
+
+void AppDescriptionList::scanStaged()
+{
+    int appsPerIdle = 0;
+    JValue criticalApps = pbnjson::Array();
+    JValueUtil::getValue(SAMConf::getInstance().getStagedBoot(), "appsPerIdle", appsPerIdle);
+    JValueUtil::getValue(SAMConf::getInstance().getStagedBoot(), "criticalApps", criticalApps);
+    if (appsPerIdle <= 0) {
+        scanFull();
+        return;
+    }
+
+    m_scanStartTime = Time::getCurrentTime();
+    m_scanStartHeap = getHeapUsage();
+
+    set<string> criticalAppIds;
+    for (int i = 0; i < criticalApps.arraySize(); ++i) {
+        if (criticalApps[i].isString())
+            criticalAppIds.insert(criticalApps[i].asString());
+    }
+
+    // Order of locations is kept for each app. add() decides which location wins.
+    list<ScanEntry> entries;
+    collectScanEntries(entries);
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (criticalAppIds.count(it->appId) == 0) {
+            ++it;
+            continue;
+        }
+        scanEntry(*it);
+        it = entries.erase(it);
+    }
+    Logger::info(getClassName(), __FUNCTION__,
+                 Logger::format("Critical apps are scanned: apps(%d) pending(%d) time(%lldms)",
+                 (int) m_map.size(), (int) entries.size(), Time::getCurrentTime() - m_scanStartTime));
+    setScanStage(ScanStage::ScanStage_Critical);
+
+    m_pendingScans.swap(entries);
+    m_pendingScanIndex.clear();
+    for (auto it = m_pendingScans.begin(); it != m_pendingScans.end(); ++it)
+        m_pendingScanIndex[it->appId].push_back(it);
+    if (m_scanSourceId == 0)
+        m_scanSourceId = g_idle_add(onScanPending, this);
+}
+
+void AppDescriptionList::scanDir(const string& path, const AppLocation& appLocation)
+{
+    list<ScanEntry> entries;
+    collectScanEntries(path, appLocation, entries);
+    for (const ScanEntry& entry : entries) {
+        scanEntry(entry);
+    }
+}
+
+bool AppDescriptionList::scanPending(const string& appId)
+{
+    auto index = m_pendingScanIndex.find(appId);
+    if (index == m_pendingScanIndex.end())
+        return false;
+
+    // Entries of all locations are scanned. add() decides which location wins.
+    list<ScanEntry> entries;
+    for (auto it : index->second)
+        entries.splice(entries.end(), m_pendingScans, it);
+    m_pendingScanIndex.erase(index);
+
+    Logger::info(getClassName(), __FUNCTION__, appId, "Requested before staged scan");
+    for (const ScanEntry& entry : entries)
+        scanEntry(entry);
+    return true;
+}
+
+void AppDescriptionList::collectScanEntries(list<ScanEntry>& entries)
+{
+    // Unchanged directories are not read again. Only their mtime is checked.
+    DirectoryCache::getInstance().revalidate();
     JValue applicationPaths = SAMConf::getInstance().getApplicationPaths();
     for (int i = 0; i < applicationPaths.arraySize(); i++) {
         string path = "";
@@ -146,67 +362,88 @@ void AppDescriptionList::scanFull()
                             Logger::format("Directory is not exist: path(%s) typeByDir(%s)", path.c_str(), typeByDir.c_str()));
             continue;
         }
-        scanDir(path, appLocation);
+        collectScanEntries(path, appLocation, entries);
     }
-    return;
 }
 
-void AppDescriptionList::scanDir(const string& path, const AppLocation& appLocation)
+void AppDescriptionList::collectScanEntries(const string& path, const AppLocation& appLocation, list<ScanEntry>& entries)
 {
-    dirent** entries = NULL;
-    int entryCount = ::scandir(path.c_str(), &entries, 0, alphasort);
-    if (entries == NULL || entryCount == 0) {
+    dirent** dirEntries = NULL;
+    int entryCount = ::scandir(path.c_str(), &dirEntries, 0, alphasort);
+    if (dirEntries == NULL || entryCount == 0) {
         Logger::warning(getClassName(), __FUNCTION__, "Failed to call scandir",
                         Logger::format("path(%s) appLocation(%s)", path.c_str(), AppDescription::toString(appLocation)));
         goto Done;
     }
 
     for (int i = 0; i < entryCount; ++i) {
-        if (!entries[i] || entries[i]->d_name[0] == '.') {
-            continue;
-        }
-        string folderPath = File::join(path, entries[i]->d_name);
-        if (SAMConf::getInstance().isBlockedApp(entries[i]->d_name)) {
-            Logger::info(getClassName(), __FUNCTION__, "BLOCKED",
-                         Logger::format("forderPath(%s)", folderPath.c_str()));
-            continue;
-        }
-        if (appLocation == AppLocation::AppLocation_System_ReadOnly &&
-            SAMConf::getInstance().isDeletedSystemApp(entries[i]->d_name)) {
-            Logger::info(getClassName(), __FUNCTION__, "DELETED",
-                         Logger::format("forderPath(%s)", folderPath.c_str()));
-            continue;
-        }
-        if (!File::isDirectory(folderPath)) {
-            Logger::warning(getClassName(), __FUNCTION__, entries[i]->d_name, folderPath + " is not exist");
-            continue;
-        }
-
-        AppDescriptionPtr appDesc = AppDescriptionList::getInstance().create(entries[i]->d_name);
-        if (!appDesc) {
-            Logger::warning(getClassName(), __FUNCTION__, entries[i]->d_name, "Cannot create application description");
-            continue;
-        }
-        if (!appDesc->scan(folderPath, appLocation)) {
-            Logger::warning(getClassName(), __FUNCTION__, entries[i]->d_name, "Cannot scan AppDescription");
+        if (!dirEntries[i] || dirEntries[i]->d_name[0] == '.') {
             continue;
         }
-        AppDescriptionList::getInstance().add(appDesc);
-
+        ScanEntry entry = { dirEntries[i]->d_name, File::join(path, dirEntries[i]->d_name), appLocation };
+        entries.push_back(entry);
     }
 
 Done:
-    if (entries != NULL) {
+    if (dirEntries != NULL) {
         for (int i = 0; i < entryCount; ++i) {
-            if (entries[i])
-                free(entries[i]);
+            if (dirEntries[i])
+                free(dirEntries[i]);
         }
-        free(entries);
-        entries = NULL;
+        free(dirEntries);
+        dirEntries = NULL;
     }
     return;
 }
 
+void AppDescriptionList::scanEntry(const ScanEntry& entry)
+{
+    if (SAMConf::getInstance().isBlockedApp(entry.appId)) {
+        Logger::info(getClassName(), __FUNCTION__, "BLOCKED",
+                     Logger::format("forderPath(%s)", entry.folderPath.c_str()));
+        return;
+    }
+    if (entry.appLocation == AppLocation::AppLocation_System_ReadOnly &&
+        SAMConf::getInstance().isDeletedSystemApp(entry.appId)) {
+        Logger::info(getClassName(), __FUNCTION__, "DELETED",
+                     Logger::format("forderPath(%s)", entry.folderPath.c_str()));
+        return;
+    }
+    if (!File::isDirectory(entry.folderPath)) {
+        Logger::warning(getClassName(), __FUNCTION__, entry.appId, entry.folderPath + " is not exist");
+        return;
+    }
+
+    AppDescriptionPtr appDesc = AppDescriptionList::getInstance().create(entry.appId);
+    if (!appDesc) {
+        Logger::warning(getClassName(), __FUNCTION__, entry.appId, "Cannot create application description");
+        return;
+    }
+    if (!appDesc->scan(entry.folderPath, entry.appLocation)) {
+        Logger::warning(getClassName(), __FUNCTION__, entry.appId, "Cannot scan AppDescription");
+        return;
+    }
+    AppDescriptionList::getInstance().add(appDesc);
+}
+
+void AppDescriptionList::setScanStage(ScanStage stage)
+{
+    m_scanStage = stage;
+    Logger::info(getClassName(), __FUNCTION__, toString(stage));
+    EventScanStageChanged(stage);
+}
+
+void AppDescriptionList::logScanBenchmark()
+{
+    // Heap growth includes caches kept by apps (appinfo, indexes).
+    // In staged boot, it includes allocations of other work done in main loop meanwhile.
+    int appCount = (int) m_map.size();
+    long long heap = (long long) getHeapUsage() - (long long) m_scanStartHeap;
+    Logger::info(getClassName(), __FUNCTION__, "Benchmark",
+                 Logger::format("apps(%d) time(%lldms) heap(%lldB) heapPerApp(%lldB)",
+                 appCount, Time::getCurrentTime() - m_scanStartTime, heap, appCount > 0 ? heap / appCount : 0LL));
+}
+
 AppDescriptionPtr AppDescriptionList::create(const string& appId)
 {
     if (appId.empty()) {
@@ -225,6 +462,20 @@ AppDescriptionPtr AppDescriptionList::getByAppId(const string& appId)
     return m_map[appId];
 }
 
+void AppDescriptionList::getByAppIds(const set<string>& appIds, vector<AppDescriptionPtr>& appDescs, vector<string>& notExist)
+{
+    // Both are sorted by appId. Walk them together once.
+    auto it = m_map.begin();
+    for (const string& appId : appIds) {
+        while (it != m_map.end() && it->first < appId)
+            ++it;
+        if (it != m_map.end() && it->first == appId)
+            appDescs.push_back(it->second);
+        else
+            notExist.push_back(appId);
+    }
+}
+
 bool AppDescriptionList::add(AppDescriptionPtr newAppDesc)
 {
     if (newAppDesc == nullptr) {
@@ -239,6 +490,9 @@ bool AppDescriptionList::add(AppDescriptionPtr newAppDesc)
     if (m_map.find(newAppDesc->getAppId()) == m_map.end()) {
         Logger::info(getClassName(), __FUNCTION__, newAppDesc->getAppId() + " is added");
         m_map[newAppDesc->getAppId()] = newAppDesc;
+        m_searchIndex.add(newAppDesc);
+        m_handlerTable.add(newAppDesc);
+        m_generation++;
         ApplicationManager::getInstance().postListApps(newAppDesc, "added", "");
         LaunchPointPtr launchPoint = LaunchPointList::getInstance().createDefault(newAppDesc);
         LaunchPointList::getInstance().add(launchPoint);
@@ -249,6 +503,9 @@ bool AppDescriptionList::add(AppDescriptionPtr newAppDesc)
         // same directory means *update*
         AppDescriptionPtr oldAppDesc = m_map[newAppDesc->getAppId()];
         m_map[newAppDesc->getAppId()] = newAppDesc;
+        m_searchIndex.add(newAppDesc);
+        m_handlerTable.add(newAppDesc);
+        m_generation++;
         ApplicationManager::getInstance().postListApps(newAppDesc, "updated", "");
         LaunchPointList::getInstance().update(oldAppDesc, newAppDesc);
     } else if (compare(m_map[newAppDesc->getAppId()], newAppDesc) || !m_map[newAppDesc->getAppId()]->scan()) {
@@ -256,6 +513,9 @@ bool AppDescriptionList::add(AppDescriptionPtr newAppDesc)
         // check version of new app description.
         AppDescriptionPtr oldAppDesc = m_map[newAppDesc->getAppId()];
         m_map[newAppDesc->getAppId()] = newAppDesc;
+        m_searchIndex.add(newAppDesc);
+        m_handlerTable.add(newAppDesc);
+        m_generation++;
         ApplicationManager::getInstance().postListApps(newAppDesc, "updated", "");
         LaunchPointList::getInstance().update(oldAppDesc, newAppDesc);
     }
@@ -308,8 +568,53 @@ void AppDescriptionList::toJson(JValue& json, JValue& properties, bool devmode)
     }
 }
 
+void AppDescriptionList::toJsonString(string& json, JValue& properties, bool devmode)
+{
+    toJsonString(json, properties, devmode, 0, INT_MAX);
+}
+
+bool AppDescriptionList::toJsonString(string& json, JValue& properties, bool devmode, int offset, int limit)
+{
+    bool hasMore = false;
+    int index = 0;
+    int count = 0;
+    json = "[";
+    for (auto appDesc : m_map) {
+        if (devmode && appDesc.second->getAppLocation() != AppLocation::AppLocation_Devmode) continue;
+        if (index++ < offset) continue;
+        if (count >= limit) {
+            hasMore = true;
+            break;
+        }
+
+        if (count++ > 0)
+            json += ",";
+        json += appDesc.second->getJsonString(properties);
+    }
+    json += "]";
+    return hasMore;
+}
+
+void AppDescriptionList::search(const string& keyword, vector<AppDescriptionPtr>& appDescs, bool devmode)
+{
+    vector<string> appIds;
+    m_searchIndex.search(keyword, appIds);
+    for (const string& appId : appIds) {
+        auto it = m_map.find(appId);
+        if (it == m_map.end())
+            continue;
+        if (devmode && it->second->getAppLocation() != AppLocation::AppLocation_Devmode)
+            continue;
+        appDescs.push_back(it->second);
+    }
+}
+
 void AppDescriptionList::onRemove(AppDescriptionPtr appDesc)
 {
+    m_searchIndex.remove(appDesc->getAppId());
+    m_handlerTable.remove(appDesc->getAppId());
+    DirectoryCache::getInstance().remove(appDesc->getFolderPath());
+    m_generation++;
     if (appDesc->isSystemApp()) {
         Logger::info(getClassName(), __FUNCTION__, appDesc->getAppId(), "remove system-app in read-write area");
         SAMConf::getInstance().appendDeletedSystemApp(appDesc->getAppId());
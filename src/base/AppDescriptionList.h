@@ -17,32 +17,60 @@
 #ifndef BASE_APPDESCRIPTIONLIST_H_
 #define BASE_APPDESCRIPTIONLIST_H_
 
+#include <glib.h>
 #include <iostream>
+#include <list>
 #include <map>
 #include <memory>
+#include <set>
+#include <vector>
+#include <boost/signals2.hpp>
 
 #include "AppDescription.h"
+#include "AppSearchIndex.h"
+#include "HandlerTable.h"
 #include "interface/IClassName.h"
 #include "interface/ISingleton.h"
 
 using namespace std;
 
+enum class ScanStage : int8_t {
+    ScanStage_None = 0,
+    ScanStage_Critical,     // Critical apps are scanned and can be launched
+    ScanStage_Full          // Whole catalog is scanned
+};
+
 class AppDescriptionList : public ISingleton<AppDescriptionList>,
                            public IClassName {
 friend class ISingleton<AppDescriptionList>;
 public:
     static bool compare(AppDescriptionPtr me, AppDescriptionPtr another);
+    static const char* toString(ScanStage stage);
 
     virtual ~AppDescriptionList();
 
+    // Reapplies locale overlays of localized apps only and posts 'listApps' once
     void changeLocale();
 
     void scanApp(const string& appId);
     void scanFull();
+    // Critical apps are scanned at once. Others are scanned in idle callbacks.
+    void scanStaged();
     void scanDir(const string& path, const AppLocation& appLocation);
+    // Scans the app right away if it is still waiting for staged scan.
+    // Called by API entry points before they look up the app. Getters never scan.
+    // Returns true if any entry of the app is scanned.
+    bool scanPending(const string& appId);
+
+    ScanStage getScanStage() const
+    {
+        return m_scanStage;
+    }
 
     AppDescriptionPtr create(const string& appId);
     AppDescriptionPtr getByAppId(const string& appId);
+    // Found apps are added to appDescs. Missing appIds are added to notExist.
+    void getByAppIds(const set<string>& appIds, vector<AppDescriptionPtr>& appDescs, vector<string>& notExist);
 
     bool add(AppDescriptionPtr appDesc);
     void removeByAppId(const string& appId);
@@ -50,13 +78,70 @@ public:
 
     bool isExist(const string& appId);
     void toJson(JValue& json, JValue& properties, bool devmode = false);
+    // Serialized array made of cached appinfo strings
+    void toJsonString(string& json, JValue& properties, bool devmode = false);
+    // Returns true if more apps are left after the page
+    bool toJsonString(string& json, JValue& properties, bool devmode, int offset, int limit);
+    void search(const string& keyword, vector<AppDescriptionPtr>& appDescs, bool devmode = false);
+
+    // Changed whenever an app is added, updated or removed. Used to validate cursor.
+    int getGeneration() const
+    {
+        return m_generation;
+    }
+
+    const HandlerTable& getHandlerTable() const
+    {
+        return m_handlerTable;
+    }
+
+    boost::signals2::signal<void(ScanStage)> EventScanStageChanged;
 
 private:
+    // Overlays of one app. Parsed by worker threads.
+    struct LocaleJob {
+        AppDescriptionPtr appDesc;
+        vector<string> dirs;
+        vector<string> paths;
+        vector<JValue> localeAppinfos;
+    };
+
+    struct LocaleJobQueue {
+        vector<LocaleJob>* jobs;
+        gint next;
+    };
+
+    struct ScanEntry {
+        string appId;
+        string folderPath;
+        AppLocation appLocation;
+    };
+
+    static gpointer onParseLocaleJobs(gpointer data);
+    static gboolean onScanPending(gpointer context);
+
     AppDescriptionList();
 
     void onRemove(AppDescriptionPtr appDesc);
 
+    void collectScanEntries(list<ScanEntry>& entries);
+    void collectScanEntries(const string& path, const AppLocation& appLocation, list<ScanEntry>& entries);
+    void scanEntry(const ScanEntry& entry);
+    void setScanStage(ScanStage stage);
+    void logScanBenchmark();
+
     map<string, AppDescriptionPtr> m_map;
+    AppSearchIndex m_searchIndex;
+    HandlerTable m_handlerTable;
+    int m_generation;
+
+    ScanStage m_scanStage;
+    list<ScanEntry> m_pendingScans;
+    // appId => its entries in m_pendingScans, in scan order
+    map<string, vector<list<ScanEntry>::iterator>> m_pendingScanIndex;
+    guint m_scanSourceId;
+    long long m_scanStartTime;
+    size_t m_scanStartHeap;
 };
 
 #endif /* BASE_APPDESCRIPTIONLIST_H_ */
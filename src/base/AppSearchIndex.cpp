@@ -0,0 +1,239 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "base/AppSearchIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unicode/unistr.h>
+
+#include "util/JValueUtil.h"
+
+// Score of a term match is field weight times match quality
+static const int QUALITY_EXACT = 4;
+static const int QUALITY_PREFIX = 3;
+static const int QUALITY_FUZZY = 1;
+
+// Bonus when whole keyword is the beginning of title
+static const int TITLE_PREFIX_BONUS = 10;
+
+string AppSearchIndex::fold(const string& text)
+{
+    string folded;
+    icu::UnicodeString::fromUTF8(text).foldCase().toUTF8String(folded);
+    return folded;
+}
+
+void AppSearchIndex::tokenize(const string& text, vector<string>& tokens)
+{
+    string folded = fold(text);
+    string token;
+    for (char c : folded) {
+        // Non-ASCII bytes are kept as a part of token
+        if ((unsigned char) c >= 0x80 || isalnum((unsigned char) c)) {
+            token += c;
+        } else if (!token.empty()) {
+            tokens.push_back(token);
+            token.clear();
+        }
+    }
+    if (!token.empty())
+        tokens.push_back(token);
+}
+
+bool AppSearchIndex::isFuzzyMatched(const string& term, const string& token)
+{
+    // Allow one typo for short terms and two for long terms
+    int maxDistance = term.length() >= 8 ? 2 : 1;
+    if (term.length() < 4)
+        return false;
+
+    // Compare with prefix of token so that unfinished typing is also matched
+    size_t length = min(token.length(), term.length() + maxDistance);
+    if (length + maxDistance < term.length())
+        return false;
+
+    // Levenshtein distance with single row
+    vector<int> row(length + 1);
+    for (size_t j = 0; j <= length; ++j)
+        row[j] = j;
+    for (size_t i = 1; i <= term.length(); ++i) {
+        int diagonal = row[0];
+        row[0] = i;
+        int rowMin = row[0];
+        for (size_t j = 1; j <= length; ++j) {
+            int above = row[j];
+            row[j] = min(min(row[j] + 1, row[j - 1] + 1), diagonal + (term[i - 1] == token[j - 1] ? 0 : 1));
+            diagonal = above;
+            rowMin = min(rowMin, row[j]);
+        }
+        if (rowMin > maxDistance)
+            return false;
+    }
+    // Any prefix of token within distance
+    for (size_t j = 0; j <= length; ++j) {
+        if (row[j] <= maxDistance)
+            return true;
+    }
+    return false;
+}
+
+AppSearchIndex::AppSearchIndex()
+{
+}
+
+AppSearchIndex::~AppSearchIndex()
+{
+}
+
+void AppSearchIndex::add(AppDescriptionPtr appDesc)
+{
+    const string& appId = appDesc->getAppId();
+    remove(appId);
+
+    vector<string> tokens;
+    tokenize(appDesc->getTitle(), tokens);
+    for (const string& token : tokens)
+        addToken(appId, token, Field_Title);
+
+    tokens.clear();
+    JValue keywords = pbnjson::Array();
+    if (JValueUtil::getValue(appDesc->getJson(), "keywords", keywords) && keywords.isArray()) {
+        for (int i = 0; i < keywords.arraySize(); ++i) {
+            if (keywords[i].isString())
+                tokenize(keywords[i].asString(), tokens);
+        }
+    }
+    for (const string& token : tokens)
+        addToken(appId, token, Field_Keyword);
+
+    tokens.clear();
+    tokenize(appId, tokens);
+    for (const string& token : tokens)
+        addToken(appId, token, Field_AppId);
+
+    m_titles[appId] = fold(appDesc->getTitle());
+}
+
+void AppSearchIndex::remove(const string& appId)
+{
+    auto document = m_documents.find(appId);
+    if (document == m_documents.end())
+        return;
+
+    for (const string& token : document->second) {
+        auto it = m_tokens.find(token);
+        if (it == m_tokens.end())
+            continue;
+        it->second.erase(appId);
+        if (it->second.empty())
+            m_tokens.erase(it);
+    }
+    m_documents.erase(document);
+    m_titles.erase(appId);
+}
+
+void AppSearchIndex::clear()
+{
+    m_tokens.clear();
+    m_documents.clear();
+    m_titles.clear();
+}
+
+void AppSearchIndex::search(const string& keyword, vector<string>& appIds) const
+{
+    vector<string> terms;
+    tokenize(keyword, terms);
+    if (terms.empty())
+        return;
+
+    map<string, int> total;
+    for (size_t i = 0; i < terms.size(); ++i) {
+        map<string, int> scores;
+        searchTerm(terms[i], scores);
+        if (i == 0) {
+            total.swap(scores);
+            continue;
+        }
+
+        // Every term should be matched
+        for (auto it = total.begin(); it != total.end();) {
+            auto score = scores.find(it->first);
+            if (score == scores.end()) {
+                it = total.erase(it);
+            } else {
+                it->second += score->second;
+                ++it;
+            }
+        }
+    }
+
+    string folded = fold(keyword);
+    vector<pair<int, string>> ranked;
+    for (auto it = total.begin(); it != total.end(); ++it) {
+        int score = it->second;
+        auto title = m_titles.find(it->first);
+        if (title != m_titles.end() && title->second.compare(0, folded.length(), folded) == 0)
+            score += TITLE_PREFIX_BONUS;
+        ranked.push_back(make_pair(-score, it->first));
+    }
+    sort(ranked.begin(), ranked.end());
+
+    for (auto it = ranked.begin(); it != ranked.end(); ++it)
+        appIds.push_back(it->second);
+}
+
+void AppSearchIndex::addToken(const string& appId, const string& token, Field field)
+{
+    int& best = m_tokens[token][appId];
+    if (best == 0)
+        m_documents[appId].push_back(token);
+    best = max(best, (int) field);
+}
+
+void AppSearchIndex::searchTerm(const string& term, map<string, int>& scores) const
+{
+    // Tokens starting with term are contiguous in sorted map
+    for (auto it = m_tokens.lower_bound(term); it != m_tokens.end(); ++it) {
+        if (it->first.compare(0, term.length(), term) != 0)
+            break;
+        int quality = it->first.length() == term.length() ? QUALITY_EXACT : QUALITY_PREFIX;
+        for (auto app = it->second.begin(); app != it->second.end(); ++app) {
+            int& score = scores[app->first];
+            score = max(score, app->second * quality);
+        }
+    }
+
+    if (term.length() < 4)
+        return;
+
+    // Fuzzy candidates share the first character with term, or start with its second one
+    // in case that first character is missing or transposed. Other tokens are not compared.
+    string heads = term.substr(0, 1);
+    if (term[1] != term[0])
+        heads += term[1];
+    for (char head : heads) {
+        for (auto it = m_tokens.lower_bound(string(1, head)); it != m_tokens.end() && it->first[0] == head; ++it) {
+            if (!isFuzzyMatched(term, it->first))
+                continue;
+            for (auto app = it->second.begin(); app != it->second.end(); ++app) {
+                int& score = scores[app->first];
+                score = max(score, app->second * QUALITY_FUZZY);
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef BASE_APPSEARCHINDEX_H_
+#define BASE_APPSEARCHINDEX_H_
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "AppDescription.h"
+
+using namespace std;
+
+// Inverted index over titles, keywords and appIds.
+// Tokens are case folded and kept sorted, so prefix lookup is a range scan.
+class AppSearchIndex {
+public:
+    AppSearchIndex();
+    virtual ~AppSearchIndex();
+
+    void add(AppDescriptionPtr appDesc);
+    void remove(const string& appId);
+    void clear();
+
+    // Every term of keyword should match. Results are ordered by score.
+    void search(const string& keyword, vector<string>& appIds) const;
+
+private:
+    enum Field {
+        Field_AppId = 1,
+        Field_Keyword = 2,
+        Field_Title = 3,
+    };
+
+    static void tokenize(const string& text, vector<string>& tokens);
+    static string fold(const string& text);
+    static bool isFuzzyMatched(const string& term, const string& token);
+
+    void addToken(const string& appId, const string& token, Field field);
+    void searchTerm(const string& term, map<string, int>& scores) const;
+
+    // token => (appId => best field)
+    map<string, map<string, int>> m_tokens;
+    // appId => tokens, used for removal
+    map<string, vector<string>> m_documents;
+    // appId => folded title, used for ranking
+    map<string, string> m_titles;
+};
+
+#endif /* BASE_APPSEARCHINDEX_H_ */
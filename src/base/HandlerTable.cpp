@@ -0,0 +1,442 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "base/HandlerTable.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <boost/algorithm/string.hpp>
+
+#include "util/JValueUtil.h"
+#include "util/Logger.h"
+
+const char* HandlerTable::WILDCARD = "*";
+const char* HandlerTable::HOST_END = "/";
+
+static const char* CLASS_NAME = "HandlerTable";
+
+bool HandlerTable::tokenize(const string& url, vector<string>& tokens)
+{
+    size_t colon = url.find(':');
+    if (colon == string::npos || colon == 0)
+        return false;
+
+    tokens.push_back(boost::to_lower_copy(url.substr(0, colon)));
+    // 'tel:', 'mailto:' and so on are handled by scheme only
+    string host;
+    size_t hostEnd = 0;
+    if (!getHost(url, host, hostEnd))
+        return true;
+
+    vector<string> labels;
+    boost::split(labels, host, boost::is_any_of("."), boost::token_compress_on);
+    for (auto it = labels.rbegin(); it != labels.rend(); ++it) {
+        if (!it->empty())
+            tokens.push_back(*it);
+    }
+    tokens.push_back(HOST_END);
+
+    size_t pathEnd = url.find_first_of("?#", hostEnd);
+    if (pathEnd == string::npos)
+        pathEnd = url.length();
+    vector<string> segments;
+    string path = url.substr(hostEnd, pathEnd - hostEnd);
+    boost::split(segments, path, boost::is_any_of("/"), boost::token_compress_on);
+    for (const string& segment : segments) {
+        if (!segment.empty())
+            tokens.push_back(segment);
+    }
+    return true;
+}
+
+bool HandlerTable::getHost(const string& url, string& host, size_t& hostEnd)
+{
+    size_t colon = url.find(':');
+    if (colon == string::npos || url.compare(colon, 3, "://") != 0)
+        return false;
+
+    size_t hostBegin = colon + 3;
+    hostEnd = url.find_first_of("/?#", hostBegin);
+    if (hostEnd == string::npos)
+        hostEnd = url.length();
+    host = url.substr(hostBegin, hostEnd - hostBegin);
+    size_t userInfo = host.rfind('@');
+    if (userInfo != string::npos)
+        host.erase(0, userInfo + 1);
+    size_t port = host.find(':');
+    if (port != string::npos)
+        host.erase(port);
+    boost::to_lower(host);
+    return true;
+}
+
+string HandlerTable::getRegexHost(const string& regex)
+{
+    // Anchored scheme without wildcards guarantees that '://' in regex is the first one in URL
+    if (regex.empty() || regex[0] != '^')
+        return "";
+    size_t separator = regex.find("://", 1);
+    if (separator == string::npos || separator == 1)
+        return "";
+    for (size_t i = 1; i < separator; ++i) {
+        if (!isalnum(regex[i]) && regex[i] != '?')
+            return "";
+    }
+
+    string host;
+    size_t i = separator + 3;
+    while (i < regex.length()) {
+        char literal = 0;
+        size_t next = i + 1;
+        if (isalnum(regex[i]) || regex[i] == '-') {
+            literal = tolower(regex[i]);
+        } else if (regex.compare(i, 2, "\\.") == 0) {
+            literal = '.';
+            next = i + 2;
+        } else {
+            break;
+        }
+        // Quantified character is not literal
+        if (next < regex.length() && strchr("?*+{", regex[next]))
+            return "";
+        host += literal;
+        i = next;
+    }
+
+    // Host must end here. Otherwise URL host can be longer than literal.
+    if (host.empty())
+        return "";
+    if (regex.compare(i, 1, "/") == 0 || regex.compare(i, 2, "\\/") == 0)
+        return host;
+    if (i + 1 == regex.length() && regex[i] == '$')
+        return host;
+    return "";
+}
+
+string HandlerTable::normalizeExtension(const string& extension)
+{
+    string normalized = boost::to_lower_copy(extension);
+    size_t dot = normalized.rfind('.');
+    if (dot != string::npos)
+        normalized.erase(0, dot + 1);
+    return normalized;
+}
+
+void HandlerTable::append(vector<string>& appIds, const vector<string>& candidates)
+{
+    for (const string& appId : candidates) {
+        if (find(appIds.begin(), appIds.end(), appId) == appIds.end())
+            appIds.push_back(appId);
+    }
+}
+
+HandlerTable::HandlerTable()
+    : m_regexSequence(0)
+{
+}
+
+HandlerTable::~HandlerTable()
+{
+}
+
+void HandlerTable::add(AppDescriptionPtr appDesc)
+{
+    const string& appId = appDesc->getAppId();
+    remove(appId);
+
+    JValue& appinfo = appDesc->getJson();
+    JValue array = pbnjson::Array();
+    if (JValueUtil::getValue(appinfo, "handlesUrls", array) && array.isArray()) {
+        for (int i = 0; i < array.arraySize(); ++i) {
+            if (array[i].isString())
+                addUrlPattern(appId, array[i].asString());
+        }
+    }
+
+    array = pbnjson::Array();
+    if (JValueUtil::getValue(appinfo, "handlesMimeTypes", array) && array.isArray()) {
+        for (int i = 0; i < array.arraySize(); ++i) {
+            if (array[i].isString())
+                addMimeType(appId, array[i].asString());
+        }
+    }
+
+    array = pbnjson::Array();
+    if (JValueUtil::getValue(appinfo, "mimeTypes", array) && array.isArray()) {
+        for (int i = 0; i < array.arraySize(); ++i) {
+            string mime = "", extension = "", scheme = "", urlPattern = "";
+            JValueUtil::getValue(array[i], "mime", mime);
+            JValueUtil::getValue(array[i], "extension", extension);
+            JValueUtil::getValue(array[i], "scheme", scheme);
+            JValueUtil::getValue(array[i], "urlPattern", urlPattern);
+
+            if (!mime.empty())
+                addMimeType(appId, mime);
+            if (!extension.empty())
+                addExtension(appId, extension, mime);
+            if (!scheme.empty())
+                addUrlPattern(appId, scheme + ":");
+            if (!urlPattern.empty())
+                addRegex(appId, urlPattern);
+        }
+    }
+}
+
+void HandlerTable::remove(const string& appId)
+{
+    auto patterns = m_urlPatterns.find(appId);
+    if (patterns != m_urlPatterns.end()) {
+        for (const string& urlPattern : patterns->second) {
+            vector<string> tokens;
+            tokenize(urlPattern, tokens);
+            vector<Node*> path(1, &m_root);
+            for (const string& token : tokens) {
+                auto child = path.back()->children.find(token);
+                if (child == path.back()->children.end())
+                    break;
+                path.push_back(child->second.get());
+            }
+            if (path.size() != tokens.size() + 1)
+                continue;
+
+            Node* node = path.back();
+            node->appIds.erase(std::remove(node->appIds.begin(), node->appIds.end(), appId), node->appIds.end());
+            // Prune nodes which are not used by any pattern
+            for (size_t i = tokens.size(); i > 0; --i) {
+                if (!path[i]->appIds.empty() || !path[i]->children.empty())
+                    break;
+                path[i - 1]->children.erase(tokens[i - 1]);
+            }
+        }
+        m_urlPatterns.erase(patterns);
+    }
+
+    for (auto it = m_mimeTypes.begin(); it != m_mimeTypes.end();) {
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), appId), it->second.end());
+        if (it->second.empty())
+            it = m_mimeTypes.erase(it);
+        else
+            ++it;
+    }
+    for (auto it = m_extensions.begin(); it != m_extensions.end();) {
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), appId), it->second.end());
+        if (it->second.empty())
+            it = m_extensions.erase(it);
+        else
+            ++it;
+    }
+    // Next declaration becomes the mime type of extension
+    for (auto it = m_extensionMimeTypes.begin(); it != m_extensionMimeTypes.end();) {
+        it->second.erase(std::remove_if(it->second.begin(), it->second.end(),
+                                        [&appId](const ExtensionMimeType& entry) { return entry.appId == appId; }),
+                         it->second.end());
+        if (it->second.empty())
+            it = m_extensionMimeTypes.erase(it);
+        else
+            ++it;
+    }
+
+    auto isOwned = [&appId](const Regex& regex) { return regex.appId == appId; };
+    m_regexes.erase(std::remove_if(m_regexes.begin(), m_regexes.end(), isOwned), m_regexes.end());
+    for (auto it = m_hostRegexes.begin(); it != m_hostRegexes.end();) {
+        it->second.erase(std::remove_if(it->second.begin(), it->second.end(), isOwned), it->second.end());
+        if (it->second.empty())
+            it = m_hostRegexes.erase(it);
+        else
+            ++it;
+    }
+}
+
+void HandlerTable::clear()
+{
+    m_root.children.clear();
+    m_root.appIds.clear();
+    m_mimeTypes.clear();
+    m_extensions.clear();
+    m_extensionMimeTypes.clear();
+    m_urlPatterns.clear();
+    m_regexes.clear();
+    m_hostRegexes.clear();
+}
+
+void HandlerTable::getHandlersForUrl(const string& url, vector<string>& appIds) const
+{
+    vector<string> tokens;
+    if (!tokenize(url, tokens))
+        return;
+
+    vector<Match> matches;
+    walk(&m_root, tokens, 0, 0, matches);
+    stable_sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) { return a.specificity > b.specificity; });
+    for (const Match& match : matches)
+        append(appIds, *match.appIds);
+
+    // Unindexed regexes and regexes indexed by host of URL. Others cannot match.
+    vector<const Regex*> regexes;
+    for (const Regex& regex : m_regexes)
+        regexes.push_back(&regex);
+    string host;
+    size_t hostEnd = 0;
+    if (getHost(url, host, hostEnd)) {
+        auto it = m_hostRegexes.find(host);
+        if (it != m_hostRegexes.end()) {
+            for (const Regex& regex : it->second)
+                regexes.push_back(&regex);
+            sort(regexes.begin(), regexes.end(), [](const Regex* a, const Regex* b) { return a->sequence < b->sequence; });
+        }
+    }
+
+    for (const Regex* regex : regexes) {
+        if (boost::regex_search(url, regex->compiled))
+            append(appIds, vector<string>(1, regex->appId));
+    }
+}
+
+void HandlerTable::getHandlersForMimeType(const string& mimeType, vector<string>& appIds) const
+{
+    string normalized = boost::to_lower_copy(mimeType);
+    auto it = m_mimeTypes.find(normalized);
+    if (it != m_mimeTypes.end())
+        append(appIds, it->second);
+
+    size_t slash = normalized.find('/');
+    if (slash == string::npos)
+        return;
+    it = m_mimeTypes.find(normalized.substr(0, slash + 1) + WILDCARD);
+    if (it != m_mimeTypes.end())
+        append(appIds, it->second);
+}
+
+void HandlerTable::getHandlersForExtension(const string& extension, vector<string>& appIds) const
+{
+    auto it = m_extensions.find(normalizeExtension(extension));
+    if (it != m_extensions.end())
+        append(appIds, it->second);
+
+    string mimeType;
+    if (getMimeTypeForExtension(extension, mimeType))
+        getHandlersForMimeType(mimeType, appIds);
+}
+
+void HandlerTable::getHandlersForUrlPattern(const string& urlPattern, vector<string>& appIds) const
+{
+    for (auto it = m_urlPatterns.begin(); it != m_urlPatterns.end(); ++it) {
+        if (find(it->second.begin(), it->second.end(), urlPattern) != it->second.end())
+            appIds.push_back(it->first);
+    }
+    for (auto it = m_regexes.begin(); it != m_regexes.end(); ++it) {
+        if (it->pattern == urlPattern)
+            append(appIds, vector<string>(1, it->appId));
+    }
+    auto regexes = m_hostRegexes.find(getRegexHost(urlPattern));
+    if (regexes == m_hostRegexes.end())
+        return;
+    for (auto it = regexes->second.begin(); it != regexes->second.end(); ++it) {
+        if (it->pattern == urlPattern)
+            append(appIds, vector<string>(1, it->appId));
+    }
+}
+
+bool HandlerTable::getMimeTypeForExtension(const string& extension, string& mimeType) const
+{
+    auto it = m_extensionMimeTypes.find(normalizeExtension(extension));
+    if (it == m_extensionMimeTypes.end())
+        return false;
+    mimeType = it->second.front().mimeType;
+    return true;
+}
+
+void HandlerTable::addUrlPattern(const string& appId, const string& urlPattern)
+{
+    vector<string> tokens;
+    if (!tokenize(urlPattern, tokens)) {
+        Logger::warning(CLASS_NAME, __FUNCTION__, appId, "Invalid url pattern: " + urlPattern);
+        return;
+    }
+
+    Node* node = &m_root;
+    for (const string& token : tokens) {
+        unique_ptr<Node>& child = node->children[token];
+        if (!child)
+            child.reset(new Node());
+        node = child.get();
+    }
+    append(node->appIds, vector<string>(1, appId));
+    m_urlPatterns[appId].push_back(urlPattern);
+}
+
+void HandlerTable::addRegex(const string& appId, const string& regex)
+{
+    Regex entry;
+    try {
+        entry.compiled.assign(regex);
+    } catch (const boost::regex_error& e) {
+        Logger::warning(CLASS_NAME, __FUNCTION__, appId, "Invalid regex: " + regex);
+        return;
+    }
+    entry.appId = appId;
+    entry.pattern = regex;
+    entry.sequence = m_regexSequence++;
+
+    string host = getRegexHost(regex);
+    if (host.empty())
+        m_regexes.push_back(entry);
+    else
+        m_hostRegexes[host].push_back(entry);
+}
+
+void HandlerTable::addMimeType(const string& appId, const string& mimeType)
+{
+    append(m_mimeTypes[boost::to_lower_copy(mimeType)], vector<string>(1, appId));
+}
+
+void HandlerTable::addExtension(const string& appId, const string& extension, const string& mimeType)
+{
+    string normalized = normalizeExtension(extension);
+    append(m_extensions[normalized], vector<string>(1, appId));
+    // First declaration wins. Others are kept for the case the first app is removed.
+    if (!mimeType.empty())
+        m_extensionMimeTypes[normalized].push_back(ExtensionMimeType { appId, boost::to_lower_copy(mimeType) });
+}
+
+void HandlerTable::walk(const Node* node, const vector<string>& tokens, size_t index, int specificity, vector<Match>& matches) const
+{
+    // Patterns are prefixes. Apps at visited node match rest of URL.
+    if (!node->appIds.empty())
+        matches.push_back(Match { specificity, &node->appIds });
+    if (index >= tokens.size())
+        return;
+
+    auto child = node->children.find(tokens[index]);
+    if (child != node->children.end())
+        walk(child->second.get(), tokens, index + 1, specificity + 1, matches);
+    if (tokens[index] == HOST_END)
+        return;
+
+    child = node->children.find(WILDCARD);
+    if (child == node->children.end())
+        return;
+
+    // Wildcard in host matches all remaining labels. Otherwise it matches one token.
+    auto hostEnd = find(tokens.begin() + index, tokens.end(), HOST_END);
+    if (index > 0 && hostEnd != tokens.end()) {
+        walk(child->second.get(), tokens, hostEnd - tokens.begin(), specificity, matches);
+    } else {
+        walk(child->second.get(), tokens, index + 1, specificity, matches);
+    }
+}
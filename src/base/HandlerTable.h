@@ -0,0 +1,118 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef BASE_HANDLERTABLE_H_
+#define BASE_HANDLERTABLE_H_
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <boost/regex.hpp>
+
+#include "AppDescription.h"
+
+using namespace std;
+
+// URL, MIME and extension handlers declared in appinfo.
+//
+// "handlesUrls": [ "https://*.example.com/watch", "tel:" ]
+// "handlesMimeTypes": [ "video/mp4", "image/*" ]
+// "mimeTypes": [ { "mime": "audio/mpeg", "extension": "mp3" }, { "urlPattern": "^https?://m\\.example\\.com/" } ]
+//
+// URL patterns are compiled into a trie of (scheme, reversed host labels, path segments)
+// so that lookup only walks tokens of the given URL. Legacy regex patterns are compiled once when added.
+// Regexes like '^https?://m\\.example\\.com/' are indexed by their literal host and tried only for that host.
+// Other regexes are tried for every URL.
+class HandlerTable {
+public:
+    HandlerTable();
+    virtual ~HandlerTable();
+
+    void add(AppDescriptionPtr appDesc);
+    void remove(const string& appId);
+    void clear();
+
+    // Most specific handler first
+    void getHandlersForUrl(const string& url, vector<string>& appIds) const;
+    void getHandlersForMimeType(const string& mimeType, vector<string>& appIds) const;
+    void getHandlersForExtension(const string& extension, vector<string>& appIds) const;
+    // Apps which declared exactly same pattern
+    void getHandlersForUrlPattern(const string& urlPattern, vector<string>& appIds) const;
+    bool getMimeTypeForExtension(const string& extension, string& mimeType) const;
+
+private:
+    struct Node {
+        unordered_map<string, unique_ptr<Node>> children;
+        vector<string> appIds;
+    };
+
+    struct Match {
+        int specificity;
+        const vector<string>* appIds;
+    };
+
+    struct Regex {
+        string appId;
+        string pattern;
+        boost::regex compiled;
+        // Declaration order across indexed and unindexed regexes
+        unsigned long sequence;
+    };
+
+    struct ExtensionMimeType {
+        string appId;
+        string mimeType;
+    };
+
+    static const char* WILDCARD;
+    static const char* HOST_END;
+
+    // Returns false if text is not URL
+    static bool tokenize(const string& url, vector<string>& tokens);
+    // Returns false if URL has no authority. hostEnd is the end of authority.
+    static bool getHost(const string& url, string& host, size_t& hostEnd);
+    // Returns lower-cased host if regex matches only URLs with that host. Otherwise empty.
+    static string getRegexHost(const string& regex);
+    static string normalizeExtension(const string& extension);
+    static void append(vector<string>& appIds, const vector<string>& candidates);
+
+    void addUrlPattern(const string& appId, const string& urlPattern);
+    void addRegex(const string& appId, const string& regex);
+    void addMimeType(const string& appId, const string& mimeType);
+    void addExtension(const string& appId, const string& extension, const string& mimeType);
+
+    void walk(const Node* node, const vector<string>& tokens, size_t index, int specificity, vector<Match>& matches) const;
+
+    Node m_root;
+    unordered_map<string, vector<string>> m_mimeTypes;
+    unordered_map<string, vector<string>> m_extensions;
+    // extension => declarations in order. First one wins.
+    unordered_map<string, vector<ExtensionMimeType>> m_extensionMimeTypes;
+
+    // appId => declared url patterns, used for removal
+    map<string, vector<string>> m_urlPatterns;
+
+    // Legacy regexes in declaration order
+    vector<Regex> m_regexes;
+    // host => legacy regexes which match only that host
+    unordered_map<string, vector<Regex>> m_hostRegexes;
+    unsigned long m_regexSequence;
+};
+
+#endif /* BASE_HANDLERTABLE_H_ */
@@ -15,7 +15,12 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "base/LaunchPoint.h"
+
+#include <boost/bind.hpp>
+
+#include "base/LaunchPointList.h"
 #include "bus/client/DB8.h"
+#include "conf/LaunchPointStore.h"
 #include "util/JValueUtil.h"
 
 string LaunchPoint::toString(const LaunchPointType type)
@@ -47,7 +52,9 @@ LaunchPoint::LaunchPoint(AppDescriptionPtr appDesc, const string& launchPointId)
     : m_type(LaunchPointType::LaunchPoint_UNKNOWN),
       m_appDesc(appDesc),
       m_launchPointId(launchPointId),
-      m_isDirty(false)
+      m_isDirty(false),
+      m_jsonRevision(-1),
+      m_sortKeyGeneration(0)
 {
     m_database = pbnjson::Object();
 }
@@ -62,51 +69,87 @@ void LaunchPoint::syncDatabase()
         return;
     }
 
-    JValue json = m_database.duplicate();
-
-    json.put("id", m_appDesc->getAppId());
-    json.put("type", toString(getType()));
-    json.put("launchPointId", m_launchPointId);
+    JValue json;
+    toDatabaseJson(json);
+    LaunchPointStore::getInstance().markDirty();
 
     bool isOld = (json.hasKey("_id") && json.hasKey("_rev") && json.hasKey("_kind"));
 
+    DB8Callback callback = boost::bind(&LaunchPoint::onSyncDatabase, m_launchPointId, boost::placeholders::_1, boost::placeholders::_2);
     if (isOld) {
-        if (DB8::getInstance().updateLaunchPoint(json)) {
+        if (DB8::getInstance().updateLaunchPoint(json, callback)) {
             m_isDirty = false;
         }
     } else {
-        if (DB8::getInstance().insertLaunchPoint(json)) {
+        if (DB8::getInstance().insertLaunchPoint(json, callback)) {
             m_isDirty = false;
         }
     }
 }
 
+void LaunchPoint::onSyncDatabase(const string launchPointId, bool isSuccess, const JValue& result)
+{
+    LaunchPointPtr launchPoint = LaunchPointList::getInstance().getByLaunchPointId(launchPointId);
+    if (launchPoint == nullptr)
+        return;
+
+    // Retry with next sync
+    if (!isSuccess) {
+        launchPoint->m_isDirty = true;
+        return;
+    }
+    for (JValue::KeyValue obj : result.children()) {
+        launchPoint->m_database.put(obj.first.asString(), obj.second);
+    }
+    LaunchPointStore::getInstance().markDirty();
+}
+
 void LaunchPoint::setDatabase(const JValue& database)
 {
-    // This method should be called by DB8 instance
+    // This method should be called by DB8 or LaunchPointStore instance
     m_database = database.duplicate();
+    m_jsonRevision = -1;
+    LaunchPointStore::getInstance().markDirty();
+    LaunchPointList::getInstance().reorder(this);
 }
 
 void LaunchPoint::updateDatabase(const JValue& json)
 {
+    bool isTitleChanged = false;
     for (JValue::KeyValue obj : json.children()) {
         string key = obj.first.asString();
 
-        if (!m_database.hasKey(key)) {
-            m_database.put(key, obj.second);
-            m_isDirty = true;
-            continue;
-        }
-
-        if (m_database[key] != obj.second) {
+        if (!m_database.hasKey(key) || m_database[key] != obj.second) {
             m_database.put(key, obj.second);
             m_isDirty = true;
+            m_jsonRevision = -1;
+            if (key == "title")
+                isTitleChanged = true;
         }
     }
+    if (isTitleChanged)
+        LaunchPointList::getInstance().reorder(this);
 }
 
 void LaunchPoint::toJson(JValue& json) const
 {
+    json = getCachedJson().duplicate();
+}
+
+const string& LaunchPoint::toJsonString() const
+{
+    getCachedJson();
+    if (m_jsonString.empty())
+        m_jsonString = m_json.stringify();
+    return m_jsonString;
+}
+
+const JValue& LaunchPoint::getCachedJson() const
+{
+    if (m_jsonRevision == m_appDesc->getRevision())
+        return m_json;
+
+    JValue& json = m_json;
     m_appDesc->toJson(json);
     for (JValue::KeyValue obj : m_database.children()) {
         string key = obj.first.asString();
@@ -133,4 +176,17 @@ void LaunchPoint::toJson(JValue& json) const
     json.put("bgImage", getBgImage());
     json.put("imageForRecents", getImageForRecents());
     json.put("largeIcon", getLargeIcon());
+
+    m_jsonString.clear();
+    m_jsonRevision = m_appDesc->getRevision();
+    return m_json;
+}
+
+void LaunchPoint::toDatabaseJson(JValue& json) const
+{
+    json = m_database.duplicate();
+
+    json.put("id", m_appDesc->getAppId());
+    json.put("type", toString(getType()));
+    json.put("launchPointId", m_launchPointId);
 }
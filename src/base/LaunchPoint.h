@@ -47,9 +47,10 @@ public:
     static string toString(const LaunchPointType type);
     static LaunchPointType toEnum(const string& type);
 
-    static bool compareTitle(LaunchPointPtr a, LaunchPointPtr b)
+    // Sort keys are binary collation keys. std::string compares them bytewise like memcmp.
+    static bool compareTitle(const LaunchPointPtr& a, const LaunchPointPtr& b)
     {
-        return a->getTitle() < b->getTitle();
+        return a->m_sortKey < b->m_sortKey;
     }
 
     LaunchPoint(AppDescriptionPtr appDesc, const string& launchPointId);
@@ -62,6 +63,7 @@ public:
     void setType(const LaunchPointType type)
     {
         m_type = type;
+        m_jsonRevision = -1;
     }
 
     AppDescriptionPtr getAppDesc() const
@@ -71,6 +73,7 @@ public:
     void setAppDesc(AppDescriptionPtr appDesc)
     {
         m_appDesc = appDesc;
+        m_jsonRevision = -1;
     }
 
     const string getAppId() const
@@ -194,8 +197,14 @@ public:
     }
 
     void toJson(JValue& json) const;
+    const string& toJsonString() const;
+    void toDatabaseJson(JValue& json) const;
 
 private:
+    static void onSyncDatabase(const string launchPointId, bool isSuccess, const JValue& result);
+
+    const JValue& getCachedJson() const;
+
     LaunchPoint(const LaunchPoint&);
     LaunchPoint& operator=(const LaunchPoint&) const;
 
@@ -206,6 +215,16 @@ private:
     bool m_isDirty;
     JValue m_database;
 
+    // Merged json of appinfo and database. Valid while m_jsonRevision equals revision of appDesc.
+    mutable JValue m_json;
+    mutable string m_jsonString;
+    mutable int m_jsonRevision;
+
+    // ICU collation key of title. It is managed by LaunchPointList.
+    string m_sortKey;
+    string m_sortKeyTitle;
+    int m_sortKeyGeneration;
+
 };
 
 #endif /* LAUNCH_POINT_H */
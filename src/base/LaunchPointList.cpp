@@ -17,31 +17,140 @@
 #include "base/LaunchPointList.h"
 
 #include <sys/time.h>
+#include <algorithm>
+#include <climits>
+#include <vector>
 #include <boost/lexical_cast.hpp>
 
 #include "RunningAppList.h"
 #include "bus/client/DB8.h"
 #include "bus/service/ApplicationManager.h"
+#include "conf/LaunchPointStore.h"
+#include "conf/SAMConf.h"
 #include "util/JValueUtil.h"
 
+static const int SORT_KEYS_PER_IDLE = 32;
+
+gboolean LaunchPointList::onUpdateSortKeys(gpointer context)
+{
+    LaunchPointList& self = LaunchPointList::getInstance();
+
+    for (int i = 0; i < SORT_KEYS_PER_IDLE && !self.m_staleSortKeys.empty(); ++i) {
+        self.updateSortKey(*self.m_staleSortKeys.front());
+        self.m_staleSortKeys.pop_front();
+    }
+    if (!self.m_staleSortKeys.empty())
+        return G_SOURCE_CONTINUE;
+
+    self.m_sortKeySourceId = 0;
+    self.sort();
+    Logger::info(self.getClassName(), __FUNCTION__, "Launch points are sorted in new locale");
+    if (!self.m_isPostingSuspended)
+        ApplicationManager::getInstance().postListLaunchPoints(nullptr, "");
+    return G_SOURCE_REMOVE;
+}
+
 LaunchPointList::LaunchPointList()
+    : m_isPostingSuspended(false),
+      m_generation(0),
+      m_collatorGeneration(0),
+      m_sortKeySourceId(0)
 {
     setClassName("LaunchPointList");
 }
 
 LaunchPointList::~LaunchPointList()
 {
-
+    if (m_sortKeySourceId != 0) {
+        g_source_remove(m_sortKeySourceId);
+        m_sortKeySourceId = 0;
+    }
 }
 
 void LaunchPointList::clear()
 {
     m_list.clear();
+    m_generation++;
 }
 
 void LaunchPointList::sort()
 {
+    for (auto it = m_list.begin(); it != m_list.end(); ++it)
+        updateSortKey(**it);
     m_list.sort(LaunchPoint::compareTitle);
+    m_generation++;
+}
+
+void LaunchPointList::changeLocale()
+{
+    createCollator();
+
+    // Keys of launch points added or reordered meanwhile are already computed with new collator
+    m_staleSortKeys = m_list;
+    if (m_sortKeySourceId == 0)
+        m_sortKeySourceId = g_idle_add(onUpdateSortKeys, this);
+}
+
+void LaunchPointList::reorder(LaunchPoint* launchPoint)
+{
+    if (!updateSortKey(*launchPoint))
+        return;
+
+    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+        if (it->get() == launchPoint) {
+            LaunchPointPtr item = *it;
+            m_list.erase(it);
+            insertSorted(item);
+            m_generation++;
+            return;
+        }
+    }
+}
+
+void LaunchPointList::createCollator()
+{
+    string locale = SAMConf::getInstance().getLanguage();
+    if (!SAMConf::getInstance().getScript().empty())
+        locale += "_" + SAMConf::getInstance().getScript();
+    if (!SAMConf::getInstance().getRegion().empty())
+        locale += "_" + SAMConf::getInstance().getRegion();
+
+    UErrorCode status = U_ZERO_ERROR;
+    m_collator.reset(icu::Collator::createInstance(icu::Locale::createFromName(locale.c_str()), status));
+    if (U_FAILURE(status)) {
+        Logger::warning(getClassName(), __FUNCTION__, locale, "Failed to create collator. Titles are compared bytewise");
+        m_collator.reset();
+    }
+    m_collatorGeneration++;
+}
+
+bool LaunchPointList::updateSortKey(LaunchPoint& launchPoint)
+{
+    if (m_collatorGeneration == 0)
+        createCollator();
+
+    string title = launchPoint.getTitle();
+    if (launchPoint.m_sortKeyGeneration == m_collatorGeneration && launchPoint.m_sortKeyTitle == title)
+        return false;
+
+    launchPoint.m_sortKeyGeneration = m_collatorGeneration;
+    launchPoint.m_sortKeyTitle = title;
+    if (m_collator == nullptr) {
+        launchPoint.m_sortKey = title;
+        return true;
+    }
+
+    icu::UnicodeString source = icu::UnicodeString::fromUTF8(title);
+    vector<uint8_t> key(m_collator->getSortKey(source, nullptr, 0));
+    m_collator->getSortKey(source, key.data(), key.size());
+    launchPoint.m_sortKey.assign(key.begin(), key.end());
+    return true;
+}
+
+void LaunchPointList::insertSorted(LaunchPointPtr launchPoint)
+{
+    auto it = upper_bound(m_list.begin(), m_list.end(), launchPoint, LaunchPoint::compareTitle);
+    m_list.insert(it, launchPoint);
 }
 
 LaunchPointPtr LaunchPointList::createBootmarkByAPI(AppDescriptionPtr appDesc, const JValue& database)
@@ -127,19 +236,23 @@ LaunchPointPtr LaunchPointList::getByLaunchPointId(const string& launchPointId)
 
 bool LaunchPointList::add(LaunchPointPtr launchPoint)
 {
-    if (launchPoint == nullptr || launchPoint->getLaunchPointId().empty()) {
-        Logger::error(getClassName(), __FUNCTION__, "Invalid launchPoint");
-        return false;
-    }
-    if (isExist(launchPoint->getLaunchPointId())) {
-        Logger::error(getClassName(), __FUNCTION__, "The launchPoint is already registered");
+    if (!validate(launchPoint))
         return false;
-    }
 
     onAdd(launchPoint);
     return true;
 }
 
+bool LaunchPointList::restore(LaunchPointPtr launchPoint)
+{
+    if (!validate(launchPoint))
+        return false;
+
+    Logger::info(getClassName(), __FUNCTION__, launchPoint->getLaunchPointId() + " is restored");
+    insert(launchPoint);
+    return true;
+}
+
 bool LaunchPointList::remove(LaunchPointPtr launchPoint)
 {
     for (auto it = m_list.begin(); it != m_list.end(); ++it) {
@@ -154,11 +267,15 @@ bool LaunchPointList::remove(LaunchPointPtr launchPoint)
 
 bool LaunchPointList::update(AppDescriptionPtr oldAppDesc, AppDescriptionPtr newAppDesc)
 {
+    // onUpdate can move launch points in the list
+    vector<LaunchPointPtr> launchPoints;
     for (auto it = m_list.begin(); it != m_list.end(); ++it) {
-        if ((*it)->getAppDesc() == oldAppDesc) {
-            (*it)->setAppDesc(newAppDesc);
-            onUpdate(*it);
-        }
+        if ((*it)->getAppDesc() == oldAppDesc)
+            launchPoints.push_back(*it);
+    }
+    for (LaunchPointPtr& launchPoint : launchPoints) {
+        launchPoint->setAppDesc(newAppDesc);
+        onUpdate(launchPoint);
     }
     return true;
 }
@@ -228,6 +345,66 @@ void LaunchPointList::toJson(JValue& json)
     }
 }
 
+void LaunchPointList::toJsonString(string& json)
+{
+    toJsonString(json, 0, INT_MAX);
+}
+
+bool LaunchPointList::toJsonString(string& json, int offset, int limit)
+{
+    bool hasMore = false;
+    int index = 0;
+    int count = 0;
+    json = "[";
+    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+        if (!(*it)->isVisible())
+            continue;
+        if (index++ < offset)
+            continue;
+        if (count >= limit) {
+            hasMore = true;
+            break;
+        }
+
+        if (count++ > 0)
+            json += ",";
+        json += (*it)->toJsonString();
+    }
+    json += "]";
+    return hasMore;
+}
+
+void LaunchPointList::toDatabaseJson(JValue& json)
+{
+    if (!json.isArray()) {
+        return;
+    }
+
+    // Default launchPoints without any customization don't need to be stored
+    for (auto it = m_list.begin(); it != m_list.end(); ++it) {
+        if ((*it)->getType() == LaunchPointType::LaunchPoint_DEFAULT && (*it)->m_database.objectSize() == 0)
+            continue;
+
+        JValue item;
+        (*it)->toDatabaseJson(item);
+        json.append(item);
+    }
+}
+
+void LaunchPointList::suspendPosting()
+{
+    m_isPostingSuspended = true;
+}
+
+void LaunchPointList::resumePosting()
+{
+    if (!m_isPostingSuspended)
+        return;
+
+    m_isPostingSuspended = false;
+    ApplicationManager::getInstance().postListLaunchPoints(nullptr, "");
+}
+
 string LaunchPointList::generateLaunchPointId(LaunchPointType type, const string& appId)
 {
     if (type == LaunchPointType::LaunchPoint_DEFAULT) {
@@ -247,24 +424,54 @@ string LaunchPointList::generateLaunchPointId(LaunchPointType type, const string
     return string("");
 }
 
+bool LaunchPointList::validate(LaunchPointPtr launchPoint)
+{
+    if (launchPoint == nullptr || launchPoint->getLaunchPointId().empty()) {
+        Logger::error(getClassName(), __FUNCTION__, "Invalid launchPoint");
+        return false;
+    }
+    if (isExist(launchPoint->getLaunchPointId())) {
+        Logger::error(getClassName(), __FUNCTION__, "The launchPoint is already registered");
+        return false;
+    }
+    return true;
+}
+
+void LaunchPointList::insert(LaunchPointPtr launchPoint)
+{
+    updateSortKey(*launchPoint);
+    insertSorted(launchPoint);
+    m_generation++;
+    if (m_isPostingSuspended)
+        return;
+    ApplicationManager::getInstance().postListLaunchPoints(launchPoint, "added");
+}
+
 void LaunchPointList::onAdd(LaunchPointPtr launchPoint)
 {
     Logger::info(getClassName(), __FUNCTION__, launchPoint->getLaunchPointId() + " is added");
     launchPoint->syncDatabase();
-    m_list.push_back(launchPoint);
-    ApplicationManager::getInstance().postListLaunchPoints(launchPoint, "added");
+    insert(launchPoint);
 }
 
 void LaunchPointList::onUpdate(LaunchPointPtr launchPoint)
 {
     Logger::info(getClassName(), __FUNCTION__, launchPoint->getLaunchPointId() + " is updated");
+    reorder(launchPoint.get());
+    m_generation++;
+    if (m_isPostingSuspended)
+        return;
     ApplicationManager::getInstance().postListLaunchPoints(launchPoint, "updated");
 }
 
 void LaunchPointList::onRemove(LaunchPointPtr launchPoint)
 {
     Logger::info(getClassName(), __FUNCTION__, launchPoint->getLaunchPointId() + " is removed");
+    m_generation++;
     RunningAppList::getInstance().removeAllByLaunchPoint(launchPoint);
     DB8::getInstance().deleteLaunchPoint(launchPoint->getLaunchPointId());
+    LaunchPointStore::getInstance().markDirty();
+    if (m_isPostingSuspended)
+        return;
     ApplicationManager::getInstance().postListLaunchPoints(launchPoint, "removed");
 }
@@ -17,8 +17,11 @@
 #ifndef BASE_LAUNCHPOINTLIST_H_
 #define BASE_LAUNCHPOINTLIST_H_
 
+#include <glib.h>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <unicode/coll.h>
 
 #include "base/LunaTask.h"
 #include "interface/ISingleton.h"
@@ -36,6 +39,11 @@ public:
     void clear();
     void sort();
 
+    // Recomputes sort keys with the collator of new locale in idle batches
+    void changeLocale();
+    // Moves the launch point to its sorted position if its sort key is changed
+    void reorder(LaunchPoint* launchPoint);
+
     LaunchPointPtr createBootmarkByAPI(AppDescriptionPtr appDesc, const JValue& database);
     LaunchPointPtr createBootmarkByDB(AppDescriptionPtr appDesc, const JValue& database);
     LaunchPointPtr createDefault(AppDescriptionPtr appDesc);
@@ -45,6 +53,8 @@ public:
     LaunchPointPtr getByLaunchPointId(const string& launchPointId);
 
     bool add(LaunchPointPtr launchPoint);
+    // Adds launchPoint which is restored from local snapshot. It is not synced to DB8 again.
+    bool restore(LaunchPointPtr launchPoint);
     bool update(AppDescriptionPtr prevAppDesc, AppDescriptionPtr currAppDesc);
     bool remove(LaunchPointPtr launchPoint);
     void removeByAppDesc(AppDescriptionPtr appDesc);
@@ -53,17 +63,50 @@ public:
 
     bool isExist(const string& launchPointId);
     void toJson(JValue& json);
+    // Serialized array made of cached launch point strings
+    void toJsonString(string& json);
+    // Returns true if more launch points are left after the page
+    bool toJsonString(string& json, int offset, int limit);
+    void toDatabaseJson(JValue& json);
+
+    // Changed whenever list or order is changed. Used to validate cursor.
+    int getGeneration() const
+    {
+        return m_generation;
+    }
+
+    // Changes made while posting is suspended are posted as one full list on resume
+    void suspendPosting();
+    void resumePosting();
 
 private:
+    static gboolean onUpdateSortKeys(gpointer context);
+
     string generateLaunchPointId(LaunchPointType type, const string& appId);
 
     LaunchPointList();
 
+    void createCollator();
+    // Returns true if the sort key is recomputed
+    bool updateSortKey(LaunchPoint& launchPoint);
+    void insertSorted(LaunchPointPtr launchPoint);
+
+    bool validate(LaunchPointPtr launchPoint);
+    void insert(LaunchPointPtr launchPoint);
+
     void onAdd(LaunchPointPtr launchPoint);
     void onUpdate(LaunchPointPtr launchPoint);
     void onRemove(LaunchPointPtr launchPoint);
 
     list<LaunchPointPtr> m_list;
+
+    bool m_isPostingSuspended;
+    int m_generation;
+
+    unique_ptr<icu::Collator> m_collator;
+    int m_collatorGeneration;
+    list<LaunchPointPtr> m_staleSortKeys;
+    guint m_sortKeySourceId;
 };
 
 #endif /* BASE_LAUNCHPOINTLIST_H_ */
@@ -22,6 +22,7 @@
 #include <list>
 #include <boost/function.hpp>
 #include <string>
+#include <vector>
 
 #include <luna-service2/lunaservice.hpp>
 #include <pbnjson.hpp>
@@ -128,6 +129,11 @@ public:
     {
         return m_responsePayload;
     }
+    // Serialized value is added to response as it is
+    void putRawResponse(const string& key, const string& rawValue)
+    {
+        m_rawResponses.push_back(make_pair(key, rawValue));
+    }
 
     JValue getParams()
     {
@@ -264,7 +270,10 @@ private:
             returnValue = false;
         }
         m_responsePayload.put("returnValue", returnValue);
-        m_request.respond(m_responsePayload.stringify().c_str());
+        string payload = m_responsePayload.stringify();
+        for (auto it = m_rawResponses.begin(); it != m_rawResponses.end(); ++it)
+            JValueUtil::putRaw(payload, it->first, it->second);
+        m_request.respond(payload.c_str());
     }
 
     string m_instanceId;
@@ -276,6 +285,7 @@ private:
 
     JValue m_requestPayload;
     JValue m_responsePayload;
+    vector<pair<string, string>> m_rawResponses;
 
     int m_errorCode;
     string m_errorText;
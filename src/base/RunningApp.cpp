@@ -16,9 +16,14 @@
 
 #include "RunningApp.h"
 
+#include <boost/bind.hpp>
+
 #include "bus/client/AbsLifeHandler.h"
 #include "bus/service/ApplicationManager.h"
 #include "conf/SAMConf.h"
+#include "manager/MemoryPolicy.h"
+#include "manager/Prewarmer.h"
+#include "util/TimerWheel.h"
 
 const string RunningApp::CLASS_NAME = "RunningApp";
 
@@ -130,6 +135,7 @@ RunningApp::RunningApp(LaunchPointPtr launchPoint)
       m_lifeStatus(LifeStatus::LifeStatus_STOP),
       m_isFirstLaunch(true),
       m_killingTimer(0),
+      m_killCount(0),
       m_keepAlive(false),
       m_noSplash(true),
       m_spinner(true),
@@ -137,9 +143,12 @@ RunningApp::RunningApp(LaunchPointPtr launchPoint)
       m_token(0),
       m_context(0),
       m_ls2name(""),
-      m_isRegistered(false)
+      m_isRegistered(false),
+      m_cpuUsage(0),
+      m_oomScoreAdj(MemoryPolicy::OOM_SCORE_ADJ_UNKNOWN)
 {
     m_startTime = Time::getCurrentTime();
+    m_lastForegroundTime = m_startTime;
 }
 
 RunningApp::~RunningApp()
@@ -185,6 +194,106 @@ bool RunningApp::sendEvent(JValue& responsePayload)
     return true;
 }
 
+void RunningApp::setResourceStat(const CgroupStat& stat)
+{
+    // CPU usage(%) between two samples
+    long long elapsed = stat.sampledTime - m_resourceStat.sampledTime;
+    if (m_resourceStat.sampledTime != 0 && elapsed > 0 && stat.cpuUsageUsec >= m_resourceStat.cpuUsageUsec)
+        m_cpuUsage = (int)((stat.cpuUsageUsec - m_resourceStat.cpuUsageUsec) / (elapsed * 10));
+
+    long long peak = m_resourceStat.memoryPeak;
+    m_resourceStat = stat;
+    // kernel doesn't support 'memory.peak'. Use the highest sampled value instead.
+    if (m_resourceStat.memoryPeak == 0)
+        m_resourceStat.memoryPeak = max(peak, stat.memoryCurrent);
+}
+
+void RunningApp::toResourceJson(JValue& json)
+{
+    if (m_resourceStat.sampledTime == 0)
+        return;
+
+    JValue memory = pbnjson::Object();
+    memory.put("current", (int64_t)m_resourceStat.memoryCurrent);
+    memory.put("peak", (int64_t)m_resourceStat.memoryPeak);
+
+    JValue cpu = pbnjson::Object();
+    cpu.put("usageUsec", (int64_t)m_resourceStat.cpuUsageUsec);
+    cpu.put("userUsec", (int64_t)m_resourceStat.cpuUserUsec);
+    cpu.put("systemUsec", (int64_t)m_resourceStat.cpuSystemUsec);
+    cpu.put("usage", m_cpuUsage);
+
+    JValue io = pbnjson::Object();
+    io.put("readBytes", (int64_t)m_resourceStat.ioReadBytes);
+    io.put("writeBytes", (int64_t)m_resourceStat.ioWriteBytes);
+    io.put("readCount", (int64_t)m_resourceStat.ioReadCount);
+    io.put("writeCount", (int64_t)m_resourceStat.ioWriteCount);
+
+    JValue resources = pbnjson::Object();
+    resources.put("memory", memory);
+    resources.put("cpu", cpu);
+    resources.put("io", io);
+    resources.put("sampledTime", (int64_t)m_resourceStat.sampledTime);
+    json.put("resources", resources);
+}
+
+void RunningApp::applySchedulingPolicy(bool force)
+{
+    // WAM owns processes of web apps
+    if (m_launchPoint->getAppDesc()->getAppType() == AppType::AppType_Web)
+        return;
+    if (m_nativePocess.getPid() <= 0)
+        return;
+
+    string name;
+    switch (m_lifeStatus) {
+    case LifeStatus::LifeStatus_SPLASHING:
+    case LifeStatus::LifeStatus_SPLASHED:
+    case LifeStatus::LifeStatus_LAUNCHING:
+    case LifeStatus::LifeStatus_RELAUNCHING:
+        name = "launch";
+        break;
+
+    case LifeStatus::LifeStatus_FOREGROUND:
+        name = "foreground";
+        break;
+
+    case LifeStatus::LifeStatus_PRELOADING:
+    case LifeStatus::LifeStatus_PRELOADED:
+    case LifeStatus::LifeStatus_BACKGROUND:
+    case LifeStatus::LifeStatus_PAUSING:
+    case LifeStatus::LifeStatus_PAUSED:
+        name = "background";
+        break;
+
+    default:
+        // Closing app keeps current scheduling to exit quickly
+        return;
+    }
+    if (!force && m_schedulingPolicy == name)
+        return;
+    m_schedulingPolicy = name;
+
+    JValue policy = SAMConf::getInstance().getSchedulingPolicy(name);
+    int value = 0;
+    if (JValueUtil::getValue(policy, "nice", value))
+        m_nativePocess.setNice(value);
+    if (JValueUtil::getValue(policy, "ioPriority", value))
+        m_nativePocess.setIOPriority(value);
+
+    const string& cgroup = m_nativePocess.getCgroup();
+    if (!cgroup.empty()) {
+        if (JValueUtil::getValue(policy, "cpuWeight", value))
+            Cgroup::writeValue(cgroup, "cpu.weight", std::to_string(value));
+        if (JValueUtil::getValue(policy, "ioWeight", value))
+            Cgroup::writeValue(cgroup, "io.weight", "default " + std::to_string(value));
+        // 'cpu.uclamp.min' is only available with CONFIG_UCLAMP_TASK_GROUP
+        if (JValueUtil::getValue(policy, "uclampMin", value))
+            Cgroup::writeValue(cgroup, "cpu.uclamp.min", std::to_string(value));
+    }
+    Logger::info(CLASS_NAME, __FUNCTION__, m_instanceId, Logger::format("Scheduling: %s (%s)", getAppId().c_str(), name.c_str()));
+}
+
 void RunningApp::setLifeStatus(LifeStatus lifeStatus)
 {
     if (m_lifeStatus == lifeStatus) {
@@ -225,16 +334,29 @@ void RunningApp::setLifeStatus(LifeStatus lifeStatus)
                    m_lifeStatus == LifeStatus::LifeStatus_PAUSED ||
                    m_lifeStatus == LifeStatus::LifeStatus_PRELOADED) {
             lifeStatus = LifeStatus::LifeStatus_RELAUNCHING;
+            MemoryPolicy::getInstance().countLaunch(true);
         }
         break;
 
+    case LifeStatus::LifeStatus_SPLASHING:
+        if (m_lifeStatus == LifeStatus::LifeStatus_STOP)
+            MemoryPolicy::getInstance().countLaunch(false);
+        break;
+
     default:
         break;
     }
 
     Logger::info(CLASS_NAME, __FUNCTION__, m_instanceId,
                  Logger::format("Changed: %s (%s ==> %s)", getAppId().c_str(), toString(m_lifeStatus), toString(lifeStatus)));
+    // Leaving foreground is also the last time it was in foreground
+    if (m_lifeStatus == LifeStatus::LifeStatus_FOREGROUND || lifeStatus == LifeStatus::LifeStatus_FOREGROUND)
+        m_lastForegroundTime = Time::getCurrentTime();
     m_lifeStatus = lifeStatus;
+    applySchedulingPolicy();
+    if (m_lifeStatus == LifeStatus::LifeStatus_FOREGROUND)
+        Prewarmer::getInstance().learn(*this);
+    MemoryPolicy::getInstance().update();
 
     // Normally, transition should be completed within timeout sec
     // However, sometimes, it takes more than 10 seconds to launch the target app.
@@ -245,10 +367,10 @@ void RunningApp::setLifeStatus(LifeStatus lifeStatus)
             // Donot start killing timer in case of launching
         } else if (m_lifeStatus == LifeStatus::LifeStatus_CLOSING) {
             // App should be closed within 1 second
-            // TODO: Change this to constant variable
-            startKillingTimer(1);
+            m_killCount = 0;
+            startKillingTimer(getTimeout("closing", TIMEOUT_CLOSING));
         } else {
-            startKillingTimer(TIMEOUT_TRANSITION);
+            startKillingTimer(getTimeout("transition", TIMEOUT_TRANSITION));
         }
     } else {
         stopKillingTimer();
@@ -258,34 +380,72 @@ void RunningApp::setLifeStatus(LifeStatus lifeStatus)
     ApplicationManager::getInstance().postGetAppLifeEvents(*this);
 }
 
-gboolean RunningApp::onKillingTimer(gpointer context)
+void RunningApp::onKillingTimer(const string instanceId)
 {
-    RunningApp* self = static_cast<RunningApp*>(context);
-    if (self == nullptr) {
-        return G_SOURCE_REMOVE;
-    }
-    RunningAppPtr runningApp = RunningAppList::getInstance().getByInstanceId(self->getInstanceId());
+    RunningAppPtr runningApp = RunningAppList::getInstance().getByInstanceId(instanceId);
     if (runningApp == nullptr) {
-        return G_SOURCE_REMOVE;
+        return;
     }
-    Logger::warning(CLASS_NAME, __FUNCTION__, self->m_instanceId, "Transition is timeout");
+    runningApp->m_killingTimer = 0;
+    Logger::warning(CLASS_NAME, __FUNCTION__, instanceId, Logger::format("Transition is timeout (%s)", toString(runningApp->m_lifeStatus)));
 
+    // kill() changes status to CLOSING and closing timer is started
+    if (runningApp->m_lifeStatus != LifeStatus::LifeStatus_CLOSING) {
+        AbsLifeHandler::getLifeHandler(runningApp).kill(runningApp);
+        return;
+    }
+
+    // SIGTERM was ignored. Keep trying SIGKILL with backoff.
+    runningApp->m_killCount++;
     AbsLifeHandler::getLifeHandler(runningApp).kill(runningApp);
+    if (runningApp->m_killingTimer != 0 || RunningAppList::getInstance().getByInstanceId(instanceId) == nullptr)
+        return;
+    // Big 'closing' in config can overflow int while shifting
+    int64_t timeout = (int64_t) runningApp->getTimeout("closing", TIMEOUT_CLOSING) << min(runningApp->m_killCount, 16);
+    runningApp->startKillingTimer((guint) min(timeout, (int64_t) runningApp->getTimeout("killMax", TIMEOUT_KILL_MAX)));
+}
+
+void RunningApp::onThawedTimer(const string instanceId)
+{
+    RunningAppPtr runningApp = RunningAppList::getInstance().getByInstanceId(instanceId);
+    if (runningApp == nullptr) {
+        return;
+    }
+    runningApp->m_killingTimer = 0;
+    if (!isTransition(runningApp->m_lifeStatus))
+        return;
 
-    // It tries to kill the app continually
-    return G_SOURCE_CONTINUE;
+    // Process is alive. Only its window was not raised.
+    Logger::warning(CLASS_NAME, __FUNCTION__, instanceId, Logger::format("Foreground is not reported (%s)", toString(runningApp->m_lifeStatus)));
+    runningApp->setLifeStatus(LifeStatus::LifeStatus_BACKGROUND);
+}
+
+void RunningApp::startThawedTimer()
+{
+    stopKillingTimer();
+    m_killingTimer = TimerWheel::getInstance().add(getTimeout("thawed", TIMEOUT_THAWED), boost::bind(&RunningApp::onThawedTimer, m_instanceId));
 }
 
 void RunningApp::startKillingTimer(guint timeout)
 {
     stopKillingTimer();
-    m_killingTimer = g_timeout_add(timeout, onKillingTimer, this);
+    m_killingTimer = TimerWheel::getInstance().add(timeout, boost::bind(&RunningApp::onKillingTimer, m_instanceId));
 }
 
 void RunningApp::stopKillingTimer()
 {
     if (m_killingTimer > 0) {
-        g_source_remove(m_killingTimer);
+        TimerWheel::getInstance().remove(m_killingTimer);
         m_killingTimer = 0;
     }
 }
+
+int RunningApp::getTimeout(const string& name, int defaultTimeout)
+{
+    // App specific timeout is prior to common one
+    JValue timeouts = SAMConf::getInstance().getLifeCycleTimeout();
+    int timeout = defaultTimeout;
+    JValueUtil::getValue(timeouts, name, timeout);
+    JValueUtil::getValue(timeouts, "apps", getAppId(), name, timeout);
+    return timeout;
+}
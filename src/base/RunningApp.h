@@ -28,6 +28,7 @@
 #include "conf/SAMConf.h"
 #include "util/Logger.h"
 #include "util/Time.h"
+#include "util/Cgroup.h"
 #include "util/NativeProcess.h"
 
 //                  < RunningApp LIFECYCLES >
@@ -73,6 +74,10 @@ public:
 
     bool sendEvent(JValue& payload);
 
+    // Thawed app cannot answer the transition. It is completed by LSM report.
+    // If the report doesn't come in time, the app goes back to background instead of being killed.
+    void startThawedTimer();
+
     string getAppId() const
     {
         return m_launchPoint->getAppDesc()->getAppId();
@@ -237,6 +242,21 @@ public:
         return (now - m_startTime);
     }
 
+    // Last time when the app was in foreground. Launched time if it never was.
+    long long getLastForegroundTime() const
+    {
+        return m_lastForegroundTime;
+    }
+
+    int getOOMScoreAdj() const
+    {
+        return m_oomScoreAdj;
+    }
+    void setOOMScoreAdj(int oomScoreAdj)
+    {
+        m_oomScoreAdj = oomScoreAdj;
+    }
+
     const string& getReason() const
     {
         return m_reason;
@@ -269,6 +289,16 @@ public:
         return m_nativePocess;
     }
 
+    const CgroupStat& getResourceStat() const
+    {
+        return m_resourceStat;
+    }
+    void setResourceStat(const CgroupStat& stat);
+
+    // Scheduling is changed only when policy of the current status is different
+    void applySchedulingPolicy(bool force = false);
+    void toResourceJson(JValue& json);
+
     void toEventJson(JValue& json, LunaTaskPtr lunaTask, const string& event)
     {
         json.put("returnValue", true);
@@ -308,13 +338,18 @@ public:
 private:
     static const string CLASS_NAME;
     static const int TIMEOUT_TRANSITION = 10000; // 10 seconds
+    static const int TIMEOUT_CLOSING = 1000; // 1 second
+    static const int TIMEOUT_KILL_MAX = 8000; // 8 seconds
+    static const int TIMEOUT_THAWED = 30000; // 30 seconds
 
     RunningApp(const RunningApp&);
     RunningApp& operator=(const RunningApp&) const;
 
-    static gboolean onKillingTimer(gpointer context);
+    static void onKillingTimer(const string instanceId);
+    static void onThawedTimer(const string instanceId);
     void startKillingTimer(guint timeout);
     void stopKillingTimer();
+    int getTimeout(const string& name, int defaultTimeout);
 
     LaunchPointPtr m_launchPoint;
 
@@ -329,6 +364,7 @@ private:
     bool m_isFirstLaunch;
     long long m_startTime;
     guint m_killingTimer;
+    int m_killCount;
 
     // initial parameter
     string m_preload;
@@ -347,6 +383,15 @@ private:
     bool m_isRegistered;
     LS::Message m_registeredApp;
 
+    // sampled by ResourceMonitor
+    CgroupStat m_resourceStat;
+    int m_cpuUsage;
+
+    string m_schedulingPolicy;
+
+    long long m_lastForegroundTime;
+    int m_oomScoreAdj;
+
 };
 
 typedef shared_ptr<RunningApp> RunningAppPtr;
@@ -351,7 +351,7 @@ bool RunningAppList::isTransition(bool devmodeOnly)
     return false;
 }
 
-void RunningAppList::toJson(JValue& array, bool devmodeOnly)
+void RunningAppList::toJson(JValue& array, bool devmodeOnly, bool withResources)
 {
     if (!array.isArray())
         return;
@@ -363,6 +363,8 @@ void RunningAppList::toJson(JValue& array, bool devmodeOnly)
 
          pbnjson::JValue object = pbnjson::Object();
          it->second->toAPIJson(object, true);
+         if (withResources)
+             it->second->toResourceJson(object);
          array.append(object);
     }
 }
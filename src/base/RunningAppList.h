@@ -58,7 +58,12 @@ public:
 
     bool setConext(AppType type, const int context);
     bool isTransition(bool devmodeOnly);
-    void toJson(JValue& array, bool devmodeOnly = false);
+    void toJson(JValue& array, bool devmodeOnly = false, bool withResources = false);
+
+    const map<string, RunningAppPtr>& getRunningApps() const
+    {
+        return m_map;
+    }
 
 private:
     void onAdd(RunningAppPtr runningApp);
@@ -18,25 +18,88 @@
 
 #include "base/LaunchPointList.h"
 #include "bus/service/ApplicationManager.h"
+#include "conf/LaunchPointStore.h"
 #include "conf/SAMConf.h"
 #include "util/JValueUtil.h"
 #include "util/Logger.h"
 
 const char* DB8::KIND_NAME = "com.webos.applicationManager.launchpoints:2";
 
-bool DB8::onResponse(LSHandle* sh, LSMessage* message, void* context)
+const unsigned int DB8::MAX_PENDING_WRITES = 32;
+const int DB8::FIND_LIMIT = 50;
+
+gboolean DB8::onFlush(gpointer context)
+{
+    getInstance().m_flushSourceId = 0;
+    getInstance().flush();
+    return G_SOURCE_REMOVE;
+}
+
+bool DB8::onBatch(LSHandle* sh, LSMessage* message, void* context)
 {
     Message response(message);
     JValue responsePayload = JDomParser::fromString(response.getPayload());
     Logger::logCallResponse(getInstance().getClassName(), __FUNCTION__, response, responsePayload);
 
-    if (responsePayload.isNull())
-        return false;
+    LSMessageToken token = LSMessageGetResponseToken(message);
+    auto it = getInstance().m_batchedWrites.find(token);
+    if (it == getInstance().m_batchedWrites.end()) {
+        Logger::warning(getInstance().getClassName(), __FUNCTION__, "Cannot find batched writes");
+        return true;
+    }
+    vector<BatchedWrite> batchedWrites = it->second;
+    getInstance().m_batchedWrites.erase(it);
+
+    bool returnValue = false;
+    JValue responses;
+    JValueUtil::getValue(responsePayload, "returnValue", returnValue);
+    JValueUtil::getValue(responsePayload, "responses", responses);
+    if (!returnValue) {
+        Logger::warning(getInstance().getClassName(), __FUNCTION__, Logger::format("Failed to write %d launchPoints", (int)batchedWrites.size()));
+    }
+
+    for (BatchedWrite& batchedWrite : batchedWrites) {
+        bool isSuccess = returnValue;
+        JValue result = pbnjson::Object();
+
+        if (responses.isArray() && batchedWrite.deleteOperation >= 0) {
+            JValueUtil::getValue(responses[batchedWrite.deleteOperation], "returnValue", isSuccess);
+        }
+        if (responses.isArray() && batchedWrite.writeOperation >= 0) {
+            bool isWritten = false;
+            JValueUtil::getValue(responses[batchedWrite.writeOperation], "returnValue", isWritten);
+            isSuccess = isSuccess && isWritten;
+
+            // put returns the key of each new object. Later updates can use merge with it.
+            string id, rev;
+            JValue results = responses[batchedWrite.writeOperation]["results"];
+            if (batchedWrite.objectIndex >= 0 && results.isArray() && batchedWrite.objectIndex < results.arraySize() &&
+                JValueUtil::getValue(results[batchedWrite.objectIndex], "id", id)) {
+                result.put("_id", id);
+                if (results[batchedWrite.objectIndex].hasKey("rev"))
+                    result.put("_rev", results[batchedWrite.objectIndex]["rev"]);
+                result.put("_kind", KIND_NAME);
+            }
+        }
+
+        if (!isSuccess) {
+            Logger::warning(getInstance().getClassName(), __FUNCTION__, batchedWrite.launchPointId, "Failed to write launchPoint");
+        }
+        for (DB8Callback& callback : batchedWrite.callbacks) {
+            callback(isSuccess, result);
+        }
+    }
     return true;
 }
 
 DB8::DB8()
-    : AbsLunaClient("com.webos.service.db")
+    : AbsLunaClient("com.webos.service.db"),
+      m_flushSourceId(0),
+      m_isRestoring(false),
+      m_isRestoreFailed(false),
+      m_isLastPageReceived(false),
+      m_restoreSourceId(0),
+      m_restoreGeneration(0)
 {
     setClassName("DB8");
 }
@@ -46,96 +109,184 @@ DB8::~DB8()
 
 }
 
-bool DB8::insertLaunchPoint(JValue& json)
+bool DB8::insertLaunchPoint(JValue& json, DB8Callback callback)
 {
-    static string method = string("luna://") + getName() + string("/put");
-
-    if (json.isNull())
+    string launchPointId;
+    if (json.isNull() || !JValueUtil::getValue(json, "launchPointId", launchPointId))
         return false;
 
     json.put("_kind", KIND_NAME);
 
-    JValue requestPayload = pbnjson::Object();
-    requestPayload.put("objects", pbnjson::Array());
-    requestPayload["objects"].append(json);
+    PendingWrite& pendingWrite = getPendingWrite(launchPointId, callback);
+    pendingWrite.type = WriteType::WriteType_PUT;
+    pendingWrite.object = json.duplicate();
+    scheduleFlush();
+    return true;
+}
 
-    Logger::logCallRequest(getClassName(), __FUNCTION__, method, requestPayload);
-    if (!LSCallOneReply(
-        ApplicationManager::getInstance().get(),
-        method.c_str(),
-        requestPayload.stringify().c_str(),
-        onResponse,
-        nullptr,
-        nullptr,
-        nullptr
-    )) {
+bool DB8::updateLaunchPoint(const JValue& props, DB8Callback callback)
+{
+    string launchPointId;
+    if (props.isNull() || !JValueUtil::getValue(props, "launchPointId", launchPointId))
         return false;
+
+    PendingWrite& pendingWrite = getPendingWrite(launchPointId, callback);
+    if (pendingWrite.type == WriteType::WriteType_NONE) {
+        pendingWrite.type = WriteType::WriteType_MERGE;
+        pendingWrite.object = props.duplicate();
+    } else {
+        // Fold into queued put or merge. Newer values win.
+        for (JValue::KeyValue obj : props.children()) {
+            pendingWrite.object.put(obj.first.asString(), obj.second);
+        }
     }
+    scheduleFlush();
     return true;
 }
 
-bool DB8::updateLaunchPoint(const JValue& props)
+void DB8::deleteLaunchPoint(const string& launchPointId, DB8Callback callback)
 {
-    static string method = string("luna://") + getName() + string("/merge");
-    JValue requestPayload = pbnjson::Object();
-    JValue where = pbnjson::Array();
-    JValue query = pbnjson::Object();
+    // Queued put or merge doesn't need to be sent anymore
+    PendingWrite& pendingWrite = getPendingWrite(launchPointId, callback);
+    pendingWrite.isDeleted = true;
+    pendingWrite.type = WriteType::WriteType_NONE;
+    pendingWrite.object = JValue();
+    scheduleFlush();
+}
 
-    if (props.isNull())
-        return false;
+void DB8::flush()
+{
+    static string method = string("luna://") + getName() + string("/batch");
+
+    if (m_flushSourceId != 0) {
+        g_source_remove(m_flushSourceId);
+        m_flushSourceId = 0;
+    }
+    if (m_pendingWrites.empty())
+        return;
+    if (!isConnected()) {
+        Logger::info(getClassName(), __FUNCTION__, Logger::format("DB8 is not running. Keep %d writes until DB8 wakes up", (int)m_pendingWrites.size()));
+        return;
+    }
 
-    where.put("prop", "launchPointId");
-    where.put("op", "=");
-    where.put("val", props["launchPointId"]);
+    // Deletions go first so that delete-then-insert of same launchPointId works
+    JValue operations = pbnjson::Array();
+    JValue objects = pbnjson::Array();
+    vector<BatchedWrite> batchedWrites;
+    for (auto& it : m_pendingWrites) {
+        BatchedWrite batchedWrite;
+        batchedWrite.launchPointId = it.first;
+        batchedWrite.deleteOperation = -1;
+        batchedWrite.writeOperation = -1;
+        batchedWrite.objectIndex = -1;
+        batchedWrite.callbacks = it.second.callbacks;
+
+        if (it.second.isDeleted) {
+            JValue where = pbnjson::Object();
+            where.put("prop", "launchPointId");
+            where.put("op", "=");
+            where.put("val", it.first);
+
+            JValue params = pbnjson::Object();
+            params.put("query", pbnjson::Object());
+            params["query"].put("from", KIND_NAME);
+            params["query"].put("where", pbnjson::Array());
+            params["query"]["where"].append(where);
+
+            JValue operation = pbnjson::Object();
+            operation.put("method", "del");
+            operation.put("params", params);
+
+            batchedWrite.deleteOperation = operations.arraySize();
+            operations.append(operation);
+        }
+        batchedWrites.push_back(batchedWrite);
+    }
 
-    query.put("where", where);
-    query.put("from", KIND_NAME);
+    // All insertions share one 'put' operation
+    int putOperation = -1;
+    int index = 0;
+    for (auto& it : m_pendingWrites) {
+        if (it.second.type == WriteType::WriteType_PUT) {
+            if (putOperation < 0) {
+                putOperation = operations.arraySize();
+                operations.append(pbnjson::Object());
+            }
+            batchedWrites[index].writeOperation = putOperation;
+            batchedWrites[index].objectIndex = objects.arraySize();
+            objects.append(it.second.object);
+        } else if (it.second.type == WriteType::WriteType_MERGE) {
+            JValue where = pbnjson::Object();
+            where.put("prop", "launchPointId");
+            where.put("op", "=");
+            where.put("val", it.first);
+
+            JValue params = pbnjson::Object();
+            params.put("props", it.second.object);
+            params.put("query", pbnjson::Object());
+            params["query"].put("from", KIND_NAME);
+            params["query"].put("where", pbnjson::Array());
+            params["query"]["where"].append(where);
+
+            JValue operation = pbnjson::Object();
+            operation.put("method", "merge");
+            operation.put("params", params);
+
+            batchedWrites[index].writeOperation = operations.arraySize();
+            operations.append(operation);
+        }
+        ++index;
+    }
+    if (putOperation >= 0) {
+        operations[putOperation].put("method", "put");
+        operations[putOperation].put("params", pbnjson::Object());
+        operations[putOperation]["params"].put("objects", objects);
+    }
+    m_pendingWrites.clear();
 
-    requestPayload.put("props", props);
-    requestPayload.put("query", query);
+    JValue requestPayload = pbnjson::Object();
+    requestPayload.put("operations", operations);
 
+    LSErrorSafe error;
+    LSMessageToken token = 0;
     Logger::logCallRequest(getClassName(), __FUNCTION__, method, requestPayload);
     if (!LSCallOneReply(
         ApplicationManager::getInstance().get(),
         method.c_str(),
         requestPayload.stringify().c_str(),
-        onResponse,
+        onBatch,
         nullptr,
-        nullptr,
-        nullptr
+        &token,
+        &error
     )) {
-        return false;
+        Logger::error(getClassName(), __FUNCTION__, error.message);
+        for (BatchedWrite& batchedWrite : batchedWrites) {
+            for (DB8Callback& callback : batchedWrite.callbacks) {
+                callback(false, pbnjson::Object());
+            }
+        }
+        return;
     }
-    return true;
+    m_batchedWrites[token] = batchedWrites;
 }
 
-void DB8::deleteLaunchPoint(const string& launchPointId)
+DB8::PendingWrite& DB8::getPendingWrite(const string& launchPointId, DB8Callback callback)
 {
-    static string method = string("luna://") + getName() + string("/del");
-    JValue requestPayload = pbnjson::Object();
-    JValue where = pbnjson::Object();
-
-    requestPayload.put("query", pbnjson::Object());
-    requestPayload["query"].put("from", KIND_NAME);
-    requestPayload["query"].put("where", pbnjson::Array());
-
-    where.put("prop", "launchPointId");
-    where.put("op", "=");
-    where.put("val", launchPointId);
-    requestPayload["query"]["where"].append(where);
+    PendingWrite& pendingWrite = m_pendingWrites[launchPointId];
+    if (callback)
+        pendingWrite.callbacks.push_back(callback);
+    return pendingWrite;
+}
 
-    Logger::logCallRequest(getClassName(), __FUNCTION__, method, requestPayload);
-    if (!LSCallOneReply(
-        ApplicationManager::getInstance().get(),
-        method.c_str(),
-        requestPayload.stringify().c_str(),
-        onResponse,
-        nullptr,
-        nullptr,
-        nullptr
-    )) {
+void DB8::scheduleFlush()
+{
+    if (m_pendingWrites.size() >= MAX_PENDING_WRITES) {
+        flush();
         return;
     }
+    if (m_flushSourceId != 0)
+        return;
+    m_flushSourceId = g_idle_add(onFlush, nullptr);
 }
 
 void DB8::onInitialzed()
@@ -145,13 +296,14 @@ void DB8::onInitialzed()
 
 void DB8::onFinalized()
 {
-
+    flush();
 }
 
 void DB8::onServerStatusChanged(bool isConnected)
 {
     if (isConnected) {
         Logger::info(getClassName(), __FUNCTION__, "DB8 is connected. Start loading launchPoints");
+        flush();
         find();
     }
 }
@@ -162,80 +314,88 @@ bool DB8::onFind(LSHandle* sh, LSMessage* message, void* context)
     JValue responsePayload = JDomParser::fromString(response.getPayload());
     Logger::logCallResponse(getInstance().getClassName(), __FUNCTION__, response, responsePayload);
 
-    if (responsePayload.isNull())
+    if (GPOINTER_TO_INT(context) != getInstance().m_restoreGeneration) {
+        Logger::info(getInstance().getClassName(), __FUNCTION__, "Drop reply of previous restore");
+        return true;
+    }
+    if (responsePayload.isNull() && !getInstance().m_isRestoring)
         return true;
 
+    // Null payload in the middle of restore is handled as failure below
     bool returnValue = false;
     JValue results;
     string errorText;
+    string next;
 
     JValueUtil::getValue(responsePayload, "returnValue", returnValue);
     JValueUtil::getValue(responsePayload, "errorText", errorText);
     JValueUtil::getValue(responsePayload, "results", results);
+    JValueUtil::getValue(responsePayload, "next", next);
 
     if (!returnValue || !results.isArray()) {
         if (!errorText.empty())
             Logger::warning(getInstance().getClassName(), __FUNCTION__, errorText);
         else
             Logger::warning(getInstance().getClassName(), __FUNCTION__, "results is not valid");
-        getInstance().putKind();
-        return true;
-    }
-    Logger::info(getInstance().getClassName(), __FUNCTION__, "Start to sync DB8");
 
-    string appId;
-    string launchPointId;
-    string type;
-    AppDescriptionPtr appDesc = nullptr;
-    LaunchPointPtr launchPoint = nullptr;
-    int size = results.arraySize();
-    for (int i = 0; i < size; ++i) {
-        if (!JValueUtil::getValue(results[i], "id", appId) ||
-            !JValueUtil::getValue(results[i], "launchPointId", launchPointId) ||
-            !JValueUtil::getValue(results[i], "type", type)) {
-            Logger::warning(getInstance().getClassName(), __FUNCTION__, "Invalid data in DB8");
-            continue;
-        }
-
-        if (appId.empty() || type.empty()) {
-            DB8::getInstance().deleteLaunchPoint(launchPointId);
-            continue;
+        if (!getInstance().m_isRestoring) {
+            getInstance().putKind();
+            return true;
         }
+        // Keep pages which are already received
+        getInstance().m_isRestoreFailed = true;
+        next = "";
+        results = pbnjson::Array();
+    }
 
-        appDesc = AppDescriptionList::getInstance().getByAppId(appId);
-        if (appDesc == nullptr) {
-            Logger::warning(getInstance().getClassName(), __FUNCTION__, "The app is already uninstalled");
-            DB8::getInstance().deleteLaunchPoint(launchPointId);
-            continue;
-        }
+    if (!getInstance().m_isRestoring) {
+        Logger::info(getInstance().getClassName(), __FUNCTION__, "Start to sync DB8");
+        getInstance().m_isRestoring = true;
+        LaunchPointList::getInstance().suspendPosting();
+    }
 
-        launchPoint = LaunchPointList::getInstance().getByLaunchPointId(launchPointId);
-        if (launchPoint == nullptr) {
-            Logger::warning(getClassName(), __FUNCTION__, "Cannot find launch point");
-            DB8::getInstance().deleteLaunchPoint(launchPointId);
-            continue;
-        }
-        if (type == "default") {
-            launchPoint->setDatabase(results[i]);
-        } else if (type == "bookmark") {
-            launchPoint = LaunchPointList::getInstance().createBootmarkByDB(appDesc, results[i]);
-            LaunchPointList::getInstance().add(launchPoint);
-        }
+    // Request next page while current page is restored
+    if (!next.empty()) {
+        getInstance().find(next);
+    } else {
+        getInstance().m_isLastPageReceived = true;
     }
-    Logger::info(getInstance().getClassName(), __FUNCTION__, "Complete to sync DB8");
 
-    // 여기서 LaunchPoints를 만들어 넣어야 함.
+    getInstance().m_restorePages.push_back(results);
+    if (getInstance().m_restoreSourceId == 0) {
+        getInstance().m_restoreSourceId = g_idle_add(onRestore, nullptr);
+    }
     return true;
 }
 
-void DB8::find()
+void DB8::find(const string& page)
 {
     static string method = string("luna://") + getName() + string("/find");
 
+    if (page.empty()) {
+        if (m_restoreSourceId != 0) {
+            g_source_remove(m_restoreSourceId);
+            m_restoreSourceId = 0;
+        }
+        if (m_isRestoring) {
+            m_isRestoring = false;
+            LaunchPointList::getInstance().resumePosting();
+        }
+        m_restorePages.clear();
+        m_deferredRecords.clear();
+        m_restoredLaunchPointIds.clear();
+        m_isRestoreFailed = false;
+        m_isLastPageReceived = false;
+        m_restoreGeneration++;
+    }
+
     JValue requestPayload = pbnjson::Object();
     requestPayload.put("query", pbnjson::Object());
     requestPayload["query"].put("from", KIND_NAME);
     requestPayload["query"].put("orderBy", "_rev");
+    requestPayload["query"].put("limit", FIND_LIMIT);
+    if (!page.empty())
+        requestPayload["query"].put("page", page);
 
     Logger::logCallRequest(getClassName(), __FUNCTION__, method, requestPayload);
     if (!LSCallOneReply(
@@ -243,14 +403,125 @@ void DB8::find()
         method.c_str(),
         requestPayload.stringify().c_str(),
         onFind,
-        nullptr,
+        GINT_TO_POINTER(m_restoreGeneration),
         nullptr,
         nullptr
     )) {
+        if (m_isRestoring) {
+            m_isRestoreFailed = true;
+            m_isLastPageReceived = true;
+            if (m_restoreSourceId == 0)
+                m_restoreSourceId = g_idle_add(onRestore, nullptr);
+        }
         return;
     }
 }
 
+gboolean DB8::onRestore(gpointer context)
+{
+    if (!getInstance().m_restorePages.empty()) {
+        JValue results = getInstance().m_restorePages.front();
+        getInstance().m_restorePages.pop_front();
+
+        // Hidden launchPoints are not shown by launcher. They can wait until the end.
+        int size = results.arraySize();
+        for (int i = 0; i < size; ++i) {
+            if (getInstance().isVisibleRecord(results[i]))
+                getInstance().restore(results[i]);
+            else
+                getInstance().m_deferredRecords.push_back(results[i]);
+        }
+        Logger::info(getInstance().getClassName(), __FUNCTION__, Logger::format("Restored %d records", size));
+    }
+
+    if (!getInstance().m_restorePages.empty())
+        return G_SOURCE_CONTINUE;
+
+    getInstance().m_restoreSourceId = 0;
+    if (getInstance().m_isLastPageReceived)
+        getInstance().completeRestore();
+    return G_SOURCE_REMOVE;
+}
+
+bool DB8::isVisibleRecord(const JValue& record)
+{
+    string appId;
+    string type;
+
+    if (!JValueUtil::getValue(record, "id", appId) || !JValueUtil::getValue(record, "type", type))
+        return true;
+    if (type != "default")
+        return true;
+
+    AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
+    if (appDesc == nullptr)
+        return true;
+    return appDesc->isVisible();
+}
+
+void DB8::restore(const JValue& record)
+{
+    string appId;
+    string launchPointId;
+    string type;
+
+    if (!JValueUtil::getValue(record, "id", appId) ||
+        !JValueUtil::getValue(record, "launchPointId", launchPointId) ||
+        !JValueUtil::getValue(record, "type", type)) {
+        Logger::warning(getClassName(), __FUNCTION__, "Invalid data in DB8");
+        return;
+    }
+    m_restoredLaunchPointIds.insert(launchPointId);
+
+    if (appId.empty() || type.empty()) {
+        deleteLaunchPoint(launchPointId);
+        return;
+    }
+
+    AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
+    if (appDesc == nullptr) {
+        Logger::warning(getClassName(), __FUNCTION__, "The app is already uninstalled");
+        deleteLaunchPoint(launchPointId);
+        return;
+    }
+
+    LaunchPointPtr launchPoint = LaunchPointList::getInstance().getByLaunchPointId(launchPointId);
+    if (type == "default") {
+        if (launchPoint == nullptr) {
+            Logger::warning(getClassName(), __FUNCTION__, "Cannot find launch point");
+            deleteLaunchPoint(launchPointId);
+            return;
+        }
+        launchPoint->setDatabase(record);
+    } else if (type == "bookmark") {
+        if (launchPoint != nullptr) {
+            launchPoint->setDatabase(record);
+            return;
+        }
+        launchPoint = LaunchPointList::getInstance().createBootmarkByDB(appDesc, record);
+        LaunchPointList::getInstance().add(launchPoint);
+    }
+}
+
+void DB8::completeRestore()
+{
+    for (JValue& record : m_deferredRecords) {
+        restore(record);
+    }
+    m_deferredRecords.clear();
+
+    // Partial result cannot tell which records are removed from DB8
+    if (!m_isRestoreFailed)
+        LaunchPointStore::getInstance().reconcile(m_restoredLaunchPointIds);
+    m_restoredLaunchPointIds.clear();
+    m_isRestoring = false;
+    m_isRestoreFailed = false;
+    m_isLastPageReceived = false;
+
+    Logger::info(getClassName(), __FUNCTION__, "Complete to sync DB8");
+    LaunchPointList::getInstance().resumePosting();
+}
+
 bool DB8::onPutKind(LSHandle* sh, LSMessage* message, void* context)
 {
     Message response(message);
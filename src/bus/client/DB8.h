@@ -17,7 +17,12 @@
 #ifndef BUS_CLIENT_DB8_H_
 #define BUS_CLIENT_DB8_H_
 
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
 #include <luna-service2/lunaservice.hpp>
+#include <boost/function.hpp>
 #include <boost/signals2.hpp>
 #include <pbnjson.hpp>
 
@@ -27,15 +32,19 @@
 using namespace LS;
 using namespace pbnjson;
 
+typedef boost::function<void(bool isSuccess, const JValue& result)> DB8Callback;
+
 class DB8 : public ISingleton<DB8>,
             public AbsLunaClient {
 friend class ISingleton<DB8>;
 public:
     virtual ~DB8();
 
-    bool insertLaunchPoint(JValue& json);
-    bool updateLaunchPoint(const JValue& json);
-    void deleteLaunchPoint(const string& launchPointId);
+    // Writes are queued per launchPointId and sent together with one batch call
+    bool insertLaunchPoint(JValue& json, DB8Callback callback = DB8Callback());
+    bool updateLaunchPoint(const JValue& json, DB8Callback callback = DB8Callback());
+    void deleteLaunchPoint(const string& launchPointId, DB8Callback callback = DB8Callback());
+    void flush();
 
 protected:
     // AbsLunaClient
@@ -45,11 +54,46 @@ protected:
 
 private:
     static const char* KIND_NAME;
+    static const unsigned int MAX_PENDING_WRITES;
+    static const int FIND_LIMIT;
+
+    enum class WriteType : int8_t {
+        WriteType_NONE = 0,
+        WriteType_PUT,
+        WriteType_MERGE
+    };
+
+    struct PendingWrite {
+        PendingWrite() : isDeleted(false), type(WriteType::WriteType_NONE) {}
+
+        bool isDeleted;
+        WriteType type;
+        JValue object;
+        vector<DB8Callback> callbacks;
+    };
+
+    struct BatchedWrite {
+        string launchPointId;
+        int deleteOperation;
+        int writeOperation;
+        int objectIndex;
+        vector<DB8Callback> callbacks;
+    };
 
-    static bool onResponse(LSHandle* sh, LSMessage* message, void* context);
+    static gboolean onFlush(gpointer context);
+    static bool onBatch(LSHandle* sh, LSMessage* message, void* context);
+
+    PendingWrite& getPendingWrite(const string& launchPointId, DB8Callback callback);
+    void scheduleFlush();
 
     static bool onFind(LSHandle* sh, LSMessage* message, void* context);
-    void find();
+    void find(const string& page = "");
+
+    // Each page is restored in separate idle callback to keep main loop responsive
+    static gboolean onRestore(gpointer context);
+    bool isVisibleRecord(const JValue& record);
+    void restore(const JValue& record);
+    void completeRestore();
 
     static bool onPutKind(LSHandle* sh, LSMessage* message, void* context);
     void putKind();
@@ -59,6 +103,20 @@ private:
 
     DB8();
 
+    map<string, PendingWrite> m_pendingWrites;
+    map<LSMessageToken, vector<BatchedWrite>> m_batchedWrites;
+    guint m_flushSourceId;
+
+    list<JValue> m_restorePages;
+    vector<JValue> m_deferredRecords;
+    set<string> m_restoredLaunchPointIds;
+    bool m_isRestoring;
+    bool m_isRestoreFailed;
+    bool m_isLastPageReceived;
+    guint m_restoreSourceId;
+    // Increased whenever restore is started. Replies of older restore are dropped.
+    int m_restoreGeneration;
+
 };
 
 #endif /* BUS_CLIENT_DB8_H_ */
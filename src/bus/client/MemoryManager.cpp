@@ -16,6 +16,8 @@
 
 #include "MemoryManager.h"
 
+#include "manager/MemoryPolicy.h"
+
 MemoryManager::MemoryManager()
     : AbsLunaClient("com.webos.service.memorymanager")
 {
@@ -83,7 +85,11 @@ void MemoryManager::requireMemory(RunningAppPtr runningApp, LunaTaskPtr lunaTask
     JValue requestPayload = pbnjson::Object();
 
     if (!isConnected()) {
-        Logger::warning(getClassName(), __FUNCTION__, "MemoryManager is not running. Skip memory reclaiming");
+        // SIGKILL is delivered before launching. Memory is freed while the new app is starting.
+        if (MemoryPolicy::getInstance().isUnderPressure()) {
+            Logger::warning(getClassName(), __FUNCTION__, "MemoryManager is not running. Reclaim memory locally");
+            MemoryPolicy::getInstance().reclaim(runningApp);
+        }
         lunaTask->success(lunaTask);
         return;
     }
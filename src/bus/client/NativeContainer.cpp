@@ -16,44 +16,36 @@
 
 #include "NativeContainer.h"
 
+#include <sys/wait.h>
+#include <boost/bind.hpp>
+
 #include "base/AppDescription.h"
 #include "base/LunaTaskList.h"
 #include "base/AppDescriptionList.h"
 #include "base/RunningAppList.h"
 #include "conf/SAMConf.h"
 #include "conf/RuntimeInfo.h"
+#include "util/Cgroup.h"
+#include "util/OutputCapture.h"
+#include "util/ProcessTracker.h"
 
 const string NativeContainer::KEY_NATIVE_RUNNING_APPS = "nativeRunningApps";
 int NativeContainer::s_instanceCounter = 1;
 
 void NativeContainer::onKillChildProcess(GPid pid, gint status, gpointer data)
 {
-    static string lastLogFile = "";
-
     Logger::info(getInstance().getClassName(), __FUNCTION__, Logger::format("Process(%d) was killed with status(%d)", pid, status));
-    g_spawn_close_pid(pid);
-
-    RunningAppPtr runningApp = RunningAppList::getInstance().getByPid(pid);
-    if (runningApp && !runningApp->getLinuxProcess().getStdFile().empty()) {
-        if (!lastLogFile.empty()) {
-            File::deleteFile(lastLogFile);
-        }
-        lastLogFile = runningApp->getLinuxProcess().getStdFile();
-    }
-    LunaTaskPtr lunaTask = LunaTaskList::getInstance().getByToken(pid);
-    if (runningApp == nullptr) {
-        Logger::error(getInstance().getClassName(), __FUNCTION__, "Cannot find RunningApp");
-        return;
-    }
+    getInstance().removeRunningApp(RunningAppList::getInstance().getByPid(pid), pid, status);
+}
 
-    getInstance().removeItem(pid);
-    RunningAppList::getInstance().removeByObject(runningApp);
-    if (lunaTask) {
-        lunaTask->success(lunaTask);
-    }
+void NativeContainer::onProcessExit(const string instanceId, pid_t pid, int status)
+{
+    Logger::info(getInstance().getClassName(), __FUNCTION__, Logger::format("Process(%d) was killed with status(%d)", pid, status));
+    getInstance().removeRunningApp(RunningAppList::getInstance().getByInstanceId(instanceId), pid, status);
 }
 
 NativeContainer::NativeContainer()
+    : m_removeCgroupsSourceId(0)
 {
     setClassName("NativeContainer");
 }
@@ -76,29 +68,71 @@ void NativeContainer::initialize()
     }
     g_strfreev(variables);
 
-    // Load already running native apps
+    m_cgroupPath = SAMConf::getInstance().getNativeCgroupPath();
+    if (!Cgroup::isAvailable(m_cgroupPath)) {
+        Logger::info(getClassName(), __FUNCTION__, m_cgroupPath, "cgroup is not available. Native apps are closed on pause");
+        m_cgroupPath = "";
+    }
+    // Child groups need controllers for scheduling. Not all kernels have all of them.
+    if (!m_cgroupPath.empty())
+        Cgroup::enableControllers(m_cgroupPath);
+
+    // Already running native apps are reloaded after full scan. Their launch points are not known yet.
     if (!RuntimeInfo::getInstance().getValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps)) {
         m_nativeRunninApps = pbnjson::Array();
         return;
     }
-    size = m_nativeRunninApps.arraySize();
-    for (int i = size - 1; i >= 0; --i) {
-        RunningAppPtr runningApp = RunningAppList::getInstance().createByJson(m_nativeRunninApps[i]);
-        if (runningApp == nullptr) {
+    m_savedRunningApps = m_nativeRunninApps.duplicate();
+
+    // Previous SAM could freeze them. Thaw them now even if they cannot be reloaded.
+    size = m_savedRunningApps.arraySize();
+    for (gsize i = 0; i < size; ++i) {
+        string instanceId;
+        if (m_cgroupPath.empty() || !JValueUtil::getValue(m_savedRunningApps[i], "instanceId", instanceId))
+            continue;
+        string cgroup = File::join(m_cgroupPath, instanceId);
+        if (File::isDirectory(cgroup))
+            Cgroup::thaw(cgroup);
+    }
+}
+
+void NativeContainer::reloadRunningApps()
+{
+    if (m_savedRunningApps.isNull())
+        return;
+    JValue savedRunningApps = m_savedRunningApps;
+    m_savedRunningApps = JValue();
+
+    // Apps launched after this SAM started are already known. Only saved ones are reloaded.
+    int size = savedRunningApps.arraySize();
+    for (int i = 0; i < size; ++i) {
+        int processId = -1;
+        JValueUtil::getValue(savedRunningApps[i], "processId", processId);
+        if (processId <= 0 || !File::isDirectory("/proc/" + std::to_string(processId))) {
+            removeItem(processId);
             continue;
         }
 
-        if (runningApp->getLinuxProcess().isRunning() == false) {
-            m_nativeRunninApps.remove(i);
+        RunningAppPtr runningApp = RunningAppList::getInstance().createByJson(savedRunningApps[i]);
+        if (runningApp == nullptr) {
+            Logger::warning(getClassName(), __FUNCTION__, savedRunningApps[i].stringify(), "Cannot reload running app");
             continue;
         }
 
+        string cgroup = m_cgroupPath.empty() ? "" : File::join(m_cgroupPath, runningApp->getInstanceId());
+        if (!cgroup.empty() && File::isDirectory(cgroup))
+            runningApp->getLinuxProcess().setCgroup(cgroup);
+
         // SAM doesn't know the proper status of already running native applications.
         // However, 'BACKGROUND' is reasonable status because 'FOREGROUND' event will be received from LSM
         runningApp->setLifeStatus(LifeStatus::LifeStatus_BACKGROUND);
         RunningAppList::getInstance().add(runningApp);
+
+        // It is not a child of this SAM. But its exit can be watched with pidfd.
+        if (ProcessTracker::getInstance().watch(runningApp->getProcessId(), false,
+                                                boost::bind(&NativeContainer::onProcessExit, runningApp->getInstanceId(), boost::placeholders::_1, boost::placeholders::_2)))
+            runningApp->getLinuxProcess().track();
     }
-    RuntimeInfo::getInstance().setValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps);
 }
 
 void NativeContainer::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
@@ -193,23 +227,35 @@ void NativeContainer::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
     runningApp->getLinuxProcess().addEnv("DISPLAY_ID", std::to_string(runningApp->getDisplayId()));
     runningApp->getLinuxProcess().addEnv("LS2_NAME", Logger::format("%s-%d", runningApp->getAppId().c_str(), s_instanceCounter));
 
-    runningApp->setLS2Name(Logger::format("%s-%d", runningApp->getAppId().c_str(), s_instanceCounter));
-    if (RuntimeInfo::getInstance().getUser().empty())
-        runningApp->getLinuxProcess().openStdFile(Logger::format("/var/log/%s-%d", runningApp->getAppId().c_str(), s_instanceCounter++));
-    else
-        runningApp->getLinuxProcess().openStdFile(Logger::format("/var/log/%s-%s-%d", runningApp->getAppId().c_str(), RuntimeInfo::getInstance().getUser().c_str(), s_instanceCounter++));
+    runningApp->setLS2Name(Logger::format("%s-%d", runningApp->getAppId().c_str(), s_instanceCounter++));
+    // Output is kept in memory. It is written to disk only when the app crashes.
+    int readerFd = -1;
+    int stdFd = OutputCapture::getInstance().open(runningApp->getAppId(), readerFd);
+    runningApp->getLinuxProcess().setStdFd(stdFd, readerFd);
+
+    if (!m_cgroupPath.empty()) {
+        string cgroup = File::join(m_cgroupPath, runningApp->getInstanceId());
+        if (Cgroup::create(cgroup))
+            runningApp->getLinuxProcess().setCgroup(cgroup);
+        else
+            Logger::warning(getClassName(), __FUNCTION__, runningApp->getAppId(), "Failed to create cgroup");
+    }
 
     runningApp->setLifeStatus(LifeStatus::LifeStatus_LAUNCHING);
 
     if (!runningApp->getLinuxProcess().run()) {
+        removeCgroup(runningApp);
         RunningAppList::getInstance().removeByObject(runningApp);
         lunaTask->setErrCodeAndText(ErrCode_LAUNCH, "Failed to launch process");
         lunaTask->error(lunaTask);
         return;
     }
 
-    g_child_watch_add(runningApp->getLinuxProcess().getPid(), onKillChildProcess, nullptr);
+    ProcessTracker::getInstance().watch(runningApp->getProcessId(), true,
+                                        boost::bind(&NativeContainer::onProcessExit, runningApp->getInstanceId(), boost::placeholders::_1, boost::placeholders::_2));
     runningApp->getLinuxProcess().track();
+    // pid is known after spawn. LAUNCHING was set before it.
+    runningApp->applySchedulingPolicy(true);
 
     addItem(runningApp->getInstanceId(), runningApp->getLaunchPointId(), runningApp->getProcessId(), runningApp->getDisplayId());
     Logger::info(getClassName(), __FUNCTION__, runningApp->getAppId(), Logger::format("Launch Time: %lld ms", runningApp->getTimeStamp()));
@@ -223,11 +269,25 @@ void NativeContainer::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
 
 void NativeContainer::pause(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
 {
-    close(runningApp, lunaTask);
+    // Frozen app keeps its memory and it is thawed in relaunch
+    if (runningApp->getLinuxProcess().getCgroup().empty()) {
+        close(runningApp, lunaTask);
+        return;
+    }
+
+    runningApp->setLifeStatus(LifeStatus::LifeStatus_PAUSING);
+    if (!runningApp->getLinuxProcess().freeze()) {
+        close(runningApp, lunaTask);
+        return;
+    }
+    runningApp->setLifeStatus(LifeStatus::LifeStatus_PAUSED);
+    lunaTask->success(lunaTask);
 }
 
 void NativeContainer::close(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
 {
+    // Frozen process cannot handle SIGTERM
+    runningApp->getLinuxProcess().thaw();
     runningApp->setLifeStatus(LifeStatus::LifeStatus_CLOSING);
     if (!runningApp->getLinuxProcess().term()) {
         kill(runningApp);
@@ -245,6 +305,7 @@ void NativeContainer::close(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
 
 void NativeContainer::kill(RunningAppPtr runningApp)
 {
+    runningApp->getLinuxProcess().thaw();
     runningApp->setLifeStatus(LifeStatus::LifeStatus_CLOSING);
     if (!runningApp->getLinuxProcess().kill()) {
         RunningAppList::getInstance().removeByObject(runningApp);
@@ -275,3 +336,64 @@ void NativeContainer::addItem(const string& instanceId, const string& launchPoin
     RuntimeInfo::getInstance().setValue(KEY_NATIVE_RUNNING_APPS, m_nativeRunninApps);
 }
 
+
+void NativeContainer::removeRunningApp(RunningAppPtr runningApp, GPid pid, int status)
+{
+    LunaTaskPtr lunaTask = LunaTaskList::getInstance().getByToken(pid);
+    if (runningApp == nullptr) {
+        Logger::error(getClassName(), __FUNCTION__, "Cannot find RunningApp");
+        return;
+    }
+
+    // App exited abnormally by itself
+    string path;
+    bool isCrashed = WIFSIGNALED(status) || (WIFEXITED(status) && WEXITSTATUS(status) != 0);
+    if (isCrashed && runningApp->getLifeStatus() != LifeStatus::LifeStatus_CLOSING &&
+        OutputCapture::getInstance().flush(runningApp->getAppId(), path)) {
+        Logger::warning(getClassName(), __FUNCTION__, runningApp->getAppId(), "Crashed. Output is saved in " + path);
+    }
+
+    removeItem(pid);
+    removeCgroup(runningApp);
+    RunningAppList::getInstance().removeByObject(runningApp);
+    if (lunaTask) {
+        lunaTask->success(lunaTask);
+    }
+}
+
+void NativeContainer::removeCgroup(RunningAppPtr runningApp)
+{
+    const string& cgroup = runningApp->getLinuxProcess().getCgroup();
+    if (cgroup.empty())
+        return;
+
+    // Children which left process group can be still alive in the cgroup
+    if (!Cgroup::remove(cgroup)) {
+        Cgroup::writeValue(cgroup, "cgroup.kill", "1");
+        Logger::warning(getClassName(), __FUNCTION__, runningApp->getAppId(), "cgroup is not empty. Killed remained processes");
+        // Killed processes leave the cgroup later
+        m_killedCgroups[cgroup] = CGROUP_REMOVE_RETRY;
+        if (m_removeCgroupsSourceId == 0)
+            m_removeCgroupsSourceId = g_timeout_add(CGROUP_REMOVE_INTERVAL, onRemoveCgroups, nullptr);
+    }
+}
+
+gboolean NativeContainer::onRemoveCgroups(gpointer context)
+{
+    map<string, int>& cgroups = NativeContainer::getInstance().m_killedCgroups;
+    for (auto it = cgroups.begin(); it != cgroups.end();) {
+        if (Cgroup::remove(it->first)) {
+            it = cgroups.erase(it);
+        } else if (--it->second <= 0) {
+            Logger::warning(NativeContainer::getInstance().getClassName(), __FUNCTION__, it->first, "Failed to remove cgroup");
+            it = cgroups.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (!cgroups.empty())
+        return G_SOURCE_CONTINUE;
+
+    NativeContainer::getInstance().m_removeCgroupsSourceId = 0;
+    return G_SOURCE_REMOVE;
+}
@@ -35,10 +35,13 @@ class NativeContainer : public ISingleton<NativeContainer>,
 friend class ISingleton<NativeContainer>;
 public:
     static void onKillChildProcess(GPid pid, gint status, gpointer data);
+    static void onProcessExit(const string instanceId, pid_t pid, int status);
 
     virtual ~NativeContainer();
 
     virtual void initialize();
+    // Restores native apps which were running before SAM restarted. Called once after full scan.
+    void reloadRunningApps();
 
     // AbsLifeHandler
     virtual void launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask) override;
@@ -50,14 +53,27 @@ private:
     static const string KEY_NATIVE_RUNNING_APPS;
 
     static int s_instanceCounter;
+    static const int CGROUP_REMOVE_INTERVAL = 100; // milliseconds
+    static const int CGROUP_REMOVE_RETRY = 20;
+
+    static gboolean onRemoveCgroups(gpointer context);
 
     NativeContainer();
 
     virtual void removeItem(GPid pid);
     virtual void addItem(const string& instanceId, const string& launchPointId, const int processId, const int displayId);
 
+    void removeCgroup(RunningAppPtr runningApp);
+    void removeRunningApp(RunningAppPtr runningApp, GPid pid, int status);
+
     map<string, string> m_environments;
     JValue m_nativeRunninApps;
+    // Loaded in initialize() and restored in reloadRunningApps()
+    JValue m_savedRunningApps;
+    string m_cgroupPath;
+    // Killed cgroups => remaining retries. cgroup.kill is asynchronous.
+    map<string, int> m_killedCgroups;
+    guint m_removeCgroupsSourceId;
 
 };
 
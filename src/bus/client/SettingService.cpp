@@ -20,6 +20,7 @@
 #include <unicode/locid.h>
 
 #include "base/AppDescriptionList.h"
+#include "base/LaunchPointList.h"
 #include "bus/service/ApplicationManager.h"
 #include "conf/SAMConf.h"
 #include "util/JValueUtil.h"
@@ -29,7 +30,7 @@ SettingService::SettingService()
 {
     setClassName("SettingService");
 
-    JValue localeInfo = JDomParser::fromFile(PATH_LOCALE_INFO);
+    JValue localeInfo = JValueUtil::parseFile(PATH_LOCALE_INFO);
     updateLocaleInfo(localeInfo);
 }
 
@@ -220,5 +221,6 @@ void SettingService::updateLocaleInfo(const JValue& settings)
 
     SAMConf::getInstance().setLocale(language, script, region);
     AppDescriptionList::getInstance().changeLocale();
+    LaunchPointList::getInstance().changeLocale();
 
 }
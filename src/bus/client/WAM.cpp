@@ -189,10 +189,6 @@ void WAM::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
         return;
     }
 
-    JValue appDesc = pbnjson::Object();
-    runningApp->getLaunchPoint()->toJson(appDesc);
-
-    requestPayload.put("appDesc", appDesc);
     requestPayload.put("appId", runningApp->getAppId());
     requestPayload.put("instanceId", runningApp->getInstanceId());
     requestPayload.put("reason", lunaTask->getReason());
@@ -213,11 +209,14 @@ void WAM::launch(RunningAppPtr runningApp, LunaTaskPtr lunaTask)
 
     LSErrorSafe error;
     LSMessageToken token = 0;
-    Logger::logCallRequest(getClassName(), __FUNCTION__, method, requestPayload);
+    // 'appDesc' is the biggest part of request. Its cached string is used as it is.
+    string payload = requestPayload.stringify();
+    JValueUtil::putRaw(payload, "appDesc", runningApp->getLaunchPoint()->toJsonString());
+    Logger::logCallRequest(getClassName(), __FUNCTION__, method, payload);
     if (!LSCallOneReply(
         ApplicationManager::getInstance().get(),
         method.c_str(),
-        requestPayload.stringify().c_str(),
+        payload.c_str(),
         onLaunchApp,
         nullptr,
         &token,
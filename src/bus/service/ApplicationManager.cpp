@@ -27,9 +27,11 @@
 #include "bus/client/DB8.h"
 #include "bus/client/LSM.h"
 #include "conf/SAMConf.h"
+#include "manager/MemoryPolicy.h"
 #include "manager/PolicyManager.h"
 #include "SchemaChecker.h"
 #include "util/JValueUtil.h"
+#include "util/OutputCapture.h"
 #include "util/Time.h"
 
 const char* ApplicationManager::CATEGORY_ROOT = "/";
@@ -48,9 +50,23 @@ const char* ApplicationManager::METHOD_REGISTER_APP = "registerApp";
 const char* ApplicationManager::METHOD_REGISTER_NATIVE_APP = "registerNativeApp";
 
 const char* ApplicationManager::METHOD_LIST_APPS = "listApps";
+const char* ApplicationManager::METHOD_SEARCH_APPS = "searchApps";
 const char* ApplicationManager::METHOD_GET_APP_STATUS = "getAppStatus";
 const char* ApplicationManager::METHOD_GET_APP_INFO = "getAppInfo";
 const char* ApplicationManager::METHOD_GET_APP_BASE_PATH = "getAppBasePath";
+const char* ApplicationManager::METHOD_GET_MULTIPLE_APP_STATUS = "getMultipleAppStatus";
+const char* ApplicationManager::METHOD_GET_MULTIPLE_APP_INFO = "getMultipleAppInfo";
+const char* ApplicationManager::METHOD_GET_CATALOG_STATUS = "getCatalogStatus";
+
+const char* ApplicationManager::METHOD_GET_HANDLER_FOR_URL = "getHandlerForUrl";
+const char* ApplicationManager::METHOD_GET_HANDLER_FOR_MIME_TYPE = "getHandlerForMimeType";
+const char* ApplicationManager::METHOD_GET_HANDLER_FOR_EXTENSION = "getHandlerForExtension";
+const char* ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_URL = "listAllHandlersForUrl";
+const char* ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_URL_PATTERN = "listAllHandlersForUrlPattern";
+const char* ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_URL_PATTERN = "listAllHandlersForMultipleUrlPattern";
+const char* ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_MIME = "listAllHandlersForMime";
+const char* ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_MIME = "listAllHandlersForMultipleMime";
+const char* ApplicationManager::METHOD_MIME_TYPE_FOR_EXTENSION = "mimeTypeForExtension";
 
 const char* ApplicationManager::METHOD_ADD_LAUNCHPOINT = "addLaunchPoint";
 const char* ApplicationManager::METHOD_UPDATE_LAUNCHPOINT = "updateLaunchPoint";
@@ -58,6 +74,7 @@ const char* ApplicationManager::METHOD_REMOVE_LAUNCHPOINT = "removeLaunchPoint";
 const char* ApplicationManager::METHOD_LIST_LAUNCHPOINTS = "listLaunchPoints";
 
 const char* ApplicationManager::METHOD_MANAGER_INFO = "managerInfo";
+const char* ApplicationManager::METHOD_GET_APP_OUTPUT = "getAppOutput";
 
 LSMethod ApplicationManager::METHODS_ROOT[] = {
     { METHOD_LAUNCH,                   ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
@@ -74,9 +91,24 @@ LSMethod ApplicationManager::METHODS_ROOT[] = {
 
     // core: package
     { METHOD_LIST_APPS,                ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_SEARCH_APPS,              ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_GET_APP_STATUS,           ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_GET_APP_INFO,             ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_GET_APP_BASE_PATH,        ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_GET_MULTIPLE_APP_STATUS,  ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_GET_MULTIPLE_APP_INFO,    ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_GET_CATALOG_STATUS,       ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+
+    // core: handler
+    { METHOD_GET_HANDLER_FOR_URL,      ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_GET_HANDLER_FOR_MIME_TYPE, ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_GET_HANDLER_FOR_EXTENSION, ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_LIST_ALL_HANDLERS_FOR_URL, ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_LIST_ALL_HANDLERS_FOR_URL_PATTERN, ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_URL_PATTERN, ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_LIST_ALL_HANDLERS_FOR_MIME, ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_MIME, ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_MIME_TYPE_FOR_EXTENSION,  ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
 
     // core: launchpoint
     { METHOD_ADD_LAUNCHPOINT,          ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
@@ -90,8 +122,10 @@ LSMethod ApplicationManager::METHODS_DEV[] = {
     { METHOD_CLOSE,                    ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_CLOSE_BY_APPID,           ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_LIST_APPS,                ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_SEARCH_APPS,              ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_RUNNING,                  ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { METHOD_MANAGER_INFO,             ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
+    { METHOD_GET_APP_OUTPUT,           ApplicationManager::onAPICalled, LUNA_METHOD_FLAGS_NONE },
     { 0,                               0,                               LUNA_METHOD_FLAGS_NONE }
 };
 
@@ -149,6 +183,7 @@ Done:
 ApplicationManager::ApplicationManager()
     : LS::Handle(LS::registerService("com.webos.applicationManager")),
       m_enableSubscription(false),
+      m_streamSourceId(0),
       m_compat1("com.webos.service.applicationmanager"),
       m_compat2("com.webos.service.applicationManager")
 {
@@ -168,9 +203,23 @@ ApplicationManager::ApplicationManager()
     registerApiHandler(CATEGORY_ROOT, METHOD_REGISTER_NATIVE_APP, boost::bind(&ApplicationManager::registerApp, this, boost::placeholders::_1));
 
     registerApiHandler(CATEGORY_ROOT, METHOD_LIST_APPS, boost::bind(&ApplicationManager::listApps, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_SEARCH_APPS, boost::bind(&ApplicationManager::searchApps, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_ROOT, METHOD_GET_APP_STATUS, boost::bind(&ApplicationManager::getAppStatus, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_ROOT, METHOD_GET_APP_INFO, boost::bind(&ApplicationManager::getAppInfo, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_ROOT, METHOD_GET_APP_BASE_PATH, boost::bind(&ApplicationManager::getAppBasePath, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_GET_MULTIPLE_APP_STATUS, boost::bind(&ApplicationManager::getMultipleAppStatus, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_GET_MULTIPLE_APP_INFO, boost::bind(&ApplicationManager::getMultipleAppInfo, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_GET_CATALOG_STATUS, boost::bind(&ApplicationManager::getCatalogStatus, this, boost::placeholders::_1));
+
+    registerApiHandler(CATEGORY_ROOT, METHOD_GET_HANDLER_FOR_URL, boost::bind(&ApplicationManager::getHandlerForUrl, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_GET_HANDLER_FOR_MIME_TYPE, boost::bind(&ApplicationManager::getHandlerForMimeType, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_GET_HANDLER_FOR_EXTENSION, boost::bind(&ApplicationManager::getHandlerForExtension, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_LIST_ALL_HANDLERS_FOR_URL, boost::bind(&ApplicationManager::listAllHandlersForUrl, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_LIST_ALL_HANDLERS_FOR_URL_PATTERN, boost::bind(&ApplicationManager::listAllHandlersForUrlPattern, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_URL_PATTERN, boost::bind(&ApplicationManager::listAllHandlersForMultipleUrlPattern, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_LIST_ALL_HANDLERS_FOR_MIME, boost::bind(&ApplicationManager::listAllHandlersForMime, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_MIME, boost::bind(&ApplicationManager::listAllHandlersForMultipleMime, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_ROOT, METHOD_MIME_TYPE_FOR_EXTENSION, boost::bind(&ApplicationManager::mimeTypeForExtension, this, boost::placeholders::_1));
 
     registerApiHandler(CATEGORY_ROOT, METHOD_ADD_LAUNCHPOINT, boost::bind(&ApplicationManager::addLaunchPoint, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_ROOT, METHOD_UPDATE_LAUNCHPOINT, boost::bind(&ApplicationManager::updateLaunchPoint, this, boost::placeholders::_1));
@@ -180,8 +229,10 @@ ApplicationManager::ApplicationManager()
     registerApiHandler(CATEGORY_DEV, METHOD_CLOSE, boost::bind(&ApplicationManager::close, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_DEV, METHOD_CLOSE_BY_APPID, boost::bind(&ApplicationManager::close, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_DEV, METHOD_LIST_APPS, boost::bind(&ApplicationManager::listApps, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_DEV, METHOD_SEARCH_APPS, boost::bind(&ApplicationManager::searchApps, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_DEV, METHOD_RUNNING, boost::bind(&ApplicationManager::running, this, boost::placeholders::_1));
     registerApiHandler(CATEGORY_DEV, METHOD_MANAGER_INFO, boost::bind(&ApplicationManager::managerInfo, this, boost::placeholders::_1));
+    registerApiHandler(CATEGORY_DEV, METHOD_GET_APP_OUTPUT, boost::bind(&ApplicationManager::getAppOutput, this, boost::placeholders::_1));
 }
 
 ApplicationManager::~ApplicationManager()
@@ -205,6 +256,7 @@ bool ApplicationManager::attach(GMainLoop* gml)
         m_getAppLifeStatus = new LS::SubscriptionPoint();               m_getAppLifeStatus->setServiceHandle(this);
         m_getForgroundAppInfo = new LS::SubscriptionPoint();            m_getForgroundAppInfo->setServiceHandle(this);
         m_getForgroundAppInfoExtraInfo = new LS::SubscriptionPoint();   m_getForgroundAppInfoExtraInfo->setServiceHandle(this);
+        m_getCatalogStatus = new LS::SubscriptionPoint();               m_getCatalogStatus->setServiceHandle(this);
         m_listLaunchPointsPoint = new LS::SubscriptionPoint();          m_listLaunchPointsPoint->setServiceHandle(this);
         m_listAppsPoint = new LS::SubscriptionPoint();                  m_listAppsPoint->setServiceHandle(this);
         m_listAppsCompactPoint = new LS::SubscriptionPoint();           m_listAppsCompactPoint->setServiceHandle(this);
@@ -212,6 +264,13 @@ bool ApplicationManager::attach(GMainLoop* gml)
         m_listDevAppsCompactPoint = new LS::SubscriptionPoint();        m_listDevAppsCompactPoint->setServiceHandle(this);
         m_running = new LS::SubscriptionPoint();                        m_running->setServiceHandle(this);
         m_runningDev = new LS::SubscriptionPoint();                     m_runningDev->setServiceHandle(this);
+        m_runningResources = new LS::SubscriptionPoint();               m_runningResources->setServiceHandle(this);
+        m_runningResourcesDev = new LS::SubscriptionPoint();            m_runningResourcesDev->setServiceHandle(this);
+
+        // Cancelled 'stream' subscriptions should not get remaining pages
+        LSCallCancelNotificationAdd(this->get(), onCancelStream, nullptr, nullptr);
+        LSCallCancelNotificationAdd(m_compat1.get(), onCancelStream, nullptr, nullptr);
+        LSCallCancelNotificationAdd(m_compat2.get(), onCancelStream, nullptr, nullptr);
 
         this->attachToLoop(gml);
         m_compat1.attachToLoop(gml);
@@ -229,6 +288,7 @@ void ApplicationManager::detach()
     delete m_getAppLifeStatus;
     delete m_getForgroundAppInfo;
     delete m_getForgroundAppInfoExtraInfo;
+    delete m_getCatalogStatus;
     delete m_listLaunchPointsPoint;
     delete m_listAppsPoint;
     delete m_listAppsCompactPoint;
@@ -236,6 +296,14 @@ void ApplicationManager::detach()
     delete m_listDevAppsCompactPoint;
     delete m_running;
     delete m_runningDev;
+    delete m_runningResources;
+    delete m_runningResourcesDev;
+
+    if (m_streamSourceId != 0) {
+        g_source_remove(m_streamSourceId);
+        m_streamSourceId = 0;
+    }
+    m_streams.clear();
 
     Handle::detach();
     m_compat1.detach();
@@ -244,6 +312,9 @@ void ApplicationManager::detach()
 
 void ApplicationManager::launch(LunaTaskPtr lunaTask)
 {
+    // Launch point of the app is created when it is scanned
+    if (!lunaTask->getAppId().empty())
+        AppDescriptionList::getInstance().scanPending(lunaTask->getAppId());
     LaunchPointPtr launchPoint = LaunchPointList::getInstance().getByLunaTask(lunaTask);
 
     // launchPoint can be nullptr because there can be only 'instanceId' in requestPayload
@@ -311,11 +382,20 @@ void ApplicationManager::close(LunaTaskPtr lunaTask)
 void ApplicationManager::running(LunaTaskPtr lunaTask)
 {
     bool subscribed = false;
+    bool resources = false;
 
-    makeRunning(lunaTask->getResponsePayload(), lunaTask->isDevmodeRequest());
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "resources", resources);
+    makeRunning(lunaTask->getResponsePayload(), lunaTask->isDevmodeRequest(), resources);
     lunaTask->getResponsePayload().put("returnValue", true);
 
-    if (lunaTask->getRequest().isSubscription()) {
+    // Resource subscribers are posted whenever ResourceMonitor samples
+    if (lunaTask->getRequest().isSubscription() && resources) {
+        if (lunaTask->isDevmodeRequest()) {
+            subscribed = m_runningResourcesDev->subscribe(lunaTask->getRequest());
+        } else {
+            subscribed = m_runningResources->subscribe(lunaTask->getRequest());
+        }
+    } else if (lunaTask->getRequest().isSubscription()) {
         if (lunaTask->isDevmodeRequest()) {
             subscribed = m_runningDev->subscribe(lunaTask->getRequest());
         } else {
@@ -335,7 +415,16 @@ void ApplicationManager::getAppLifeEvents(LunaTaskPtr lunaTask)
         return;
     }
 
-    if (!m_getAppLifeEvents->subscribe(lunaTask->getRequest())) {
+    bool subscribed = false;
+    SubscriptionFilter filter;
+    if (filter.parse(lunaTask->getRequestPayload())) {
+        m_getAppLifeEventsFilters[filter.getKey(METHOD_GET_APP_LIFE_EVENTS)] = filter;
+        subscribed = subscribeWithFilter(lunaTask, filter.getKey(METHOD_GET_APP_LIFE_EVENTS), m_getAppLifeEventsFilters);
+    } else {
+        subscribed = m_getAppLifeEvents->subscribe(lunaTask->getRequest());
+    }
+
+    if (!subscribed) {
         lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Subscription failed");
         lunaTask->getResponsePayload().put("subscribed", false);
     } else {
@@ -353,7 +442,16 @@ void ApplicationManager::getAppLifeStatus(LunaTaskPtr lunaTask)
         return;
     }
 
-    if (!m_getAppLifeStatus->subscribe(lunaTask->getRequest())) {
+    bool subscribed = false;
+    SubscriptionFilter filter;
+    if (filter.parse(lunaTask->getRequestPayload())) {
+        m_getAppLifeStatusFilters[filter.getKey(METHOD_GET_APP_LIFE_STATUS)] = filter;
+        subscribed = subscribeWithFilter(lunaTask, filter.getKey(METHOD_GET_APP_LIFE_STATUS), m_getAppLifeStatusFilters);
+    } else {
+        subscribed = m_getAppLifeStatus->subscribe(lunaTask->getRequest());
+    }
+
+    if (!subscribed) {
         lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Subscription failed");
         lunaTask->getResponsePayload().put("subscribed", false);
     } else {
@@ -393,6 +491,7 @@ void ApplicationManager::lockApp(LunaTaskPtr lunaTask)
     JValueUtil::getValue(lunaTask->getRequestPayload(), "id", appId);
     JValueUtil::getValue(lunaTask->getRequestPayload(), "lock", lock);
 
+    AppDescriptionList::getInstance().scanPending(appId);
     AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
     if (!appDesc) {
         lunaTask->setErrCodeAndText(ErrCode_GENERAL, appId + " was not found OR Unsupported Application Type");
@@ -431,19 +530,67 @@ void ApplicationManager::registerApp(LunaTaskPtr lunaTask)
     // You don't need to reply here
 }
 
+// Cursor is "<generation>.<offset>". Empty cursor means the first page.
+static bool parseCursor(const string& cursor, int generation, int& offset)
+{
+    offset = 0;
+    if (cursor.empty())
+        return true;
+
+    int cursorGeneration = 0;
+    char tail = 0;
+    if (sscanf(cursor.c_str(), "%d.%d%c", &cursorGeneration, &offset, &tail) != 2 || offset < 0)
+        return false;
+    return cursorGeneration == generation;
+}
+
+static string makeCursor(int generation, int offset)
+{
+    return to_string(generation) + "." + to_string(offset);
+}
+
+// Pages are smaller than the whole catalog so that first paint doesn't wait for it
+static const int DEFAULT_PAGE_LIMIT = 50;
+
 void ApplicationManager::listApps(LunaTaskPtr lunaTask)
 {
-    pbnjson::JValue apps = pbnjson::Array();
+    string apps;
     pbnjson::JValue properties = pbnjson::Array();
 
     if (JValueUtil::getValue(lunaTask->getRequestPayload(), "properties", properties) && properties.arraySize() > 0) {
         properties.append("id");
     }
 
+    int limit = 0;
+    string cursor = "";
+    bool stream = false;
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "limit", limit);
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "cursor", cursor);
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "stream", stream);
+    // Chunks are delivered as subscription replies
+    stream = stream && lunaTask->getRequest().isSubscription();
+    if (stream && limit <= 0)
+        limit = DEFAULT_PAGE_LIMIT;
+
     // Don't reply 'apps' in listApps during initializaion
-    if (m_enableSubscription) {
-        AppDescriptionList::getInstance().toJson(apps, properties, lunaTask->isDevmodeRequest());
-        lunaTask->getResponsePayload().put("apps", apps);
+    if (m_enableSubscription && limit <= 0 && cursor.empty()) {
+        AppDescriptionList::getInstance().toJsonString(apps, properties, lunaTask->isDevmodeRequest());
+        lunaTask->putRawResponse("apps", apps);
+    } else if (m_enableSubscription) {
+        int generation = AppDescriptionList::getInstance().getGeneration();
+        int offset = 0;
+        if (!parseCursor(cursor, generation, offset)) {
+            lunaTask->getResponsePayload().put("generation", generation);
+            lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Invalid or outdated cursor. Request from the first page");
+            LunaTaskList::getInstance().removeAfterReply(lunaTask);
+            return;
+        }
+        if (limit <= 0)
+            limit = DEFAULT_PAGE_LIMIT;
+        bool hasMore = makeListAppsPage(lunaTask->getResponsePayload(), apps, properties, lunaTask->isDevmodeRequest(), offset, limit);
+        lunaTask->putRawResponse("apps", apps);
+        if (hasMore && stream)
+            addStream(lunaTask, true, properties, generation, offset + limit, limit);
     }
 
     if (lunaTask->getRequest().isSubscription()) {
@@ -454,6 +601,33 @@ void ApplicationManager::listApps(LunaTaskPtr lunaTask)
     LunaTaskList::getInstance().removeAfterReply(lunaTask);
 }
 
+void ApplicationManager::searchApps(LunaTaskPtr lunaTask)
+{
+    string keyword = "";
+    int limit = 0;
+    pbnjson::JValue properties = pbnjson::Array();
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "keyword", keyword);
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "limit", limit);
+    if (JValueUtil::getValue(lunaTask->getRequestPayload(), "properties", properties) && properties.arraySize() > 0) {
+        properties.append("id");
+    }
+
+    vector<AppDescriptionPtr> appDescs;
+    AppDescriptionList::getInstance().search(keyword, appDescs, lunaTask->isDevmodeRequest());
+
+    pbnjson::JValue apps = pbnjson::Array();
+    for (AppDescriptionPtr appDesc : appDescs) {
+        if (limit > 0 && apps.arraySize() >= limit)
+            break;
+        if (properties.arraySize() > 0)
+            apps.append(appDesc->getJson(properties));
+        else
+            apps.append(appDesc->getJson());
+    }
+    lunaTask->getResponsePayload().put("apps", apps);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
 void ApplicationManager::getAppStatus(LunaTaskPtr lunaTask)
 {
     string appId = lunaTask->getAppId();
@@ -479,6 +653,7 @@ void ApplicationManager::getAppStatus(LunaTaskPtr lunaTask)
     lunaTask->getResponsePayload().put("appId", appId);
     lunaTask->getResponsePayload().put("event", "nothing");
 
+    AppDescriptionList::getInstance().scanPending(appId);
     AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
     if (!appDesc) {
         lunaTask->getResponsePayload().put("status", "notExist");
@@ -508,6 +683,7 @@ void ApplicationManager::getAppInfo(LunaTaskPtr lunaTask)
         return;
     }
 
+    AppDescriptionList::getInstance().scanPending(appId);
     AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
     if (!appDesc) {
         lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Invalid appId specified OR Unsupported Application Type: " + appId);
@@ -539,6 +715,7 @@ void ApplicationManager::getAppBasePath(LunaTaskPtr lunaTask)
         LunaTaskList::getInstance().removeAfterReply(lunaTask);
         return;
     }
+    AppDescriptionList::getInstance().scanPending(appId);
     AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
     if (!appDesc) {
         lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Invalid appId specified: " + appId);
@@ -557,6 +734,254 @@ void ApplicationManager::getAppBasePath(LunaTaskPtr lunaTask)
     LunaTaskList::getInstance().removeAfterReply(lunaTask);
 }
 
+static void toJsonArray(const vector<string>& appIds, JValue& array)
+{
+    array = pbnjson::Array();
+    for (const string& appId : appIds)
+        array.append(appId);
+}
+
+static void getAppIds(const JValue& requestPayload, const string& key, set<string>& appIds)
+{
+    JValue array = pbnjson::Array();
+    JValueUtil::getValue(requestPayload, key, array);
+    for (int i = 0; i < array.arraySize(); ++i) {
+        if (array[i].isString() && !array[i].asString().empty())
+            appIds.insert(array[i].asString());
+    }
+}
+
+void ApplicationManager::getMultipleAppStatus(LunaTaskPtr lunaTask)
+{
+    set<string> appIds;
+    bool appInfo = false;
+    getAppIds(lunaTask->getRequestPayload(), "appIds", appIds);
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "appInfo", appInfo);
+
+    vector<AppDescriptionPtr> appDescs;
+    vector<string> notExist;
+    for (const string& appId : appIds)
+        AppDescriptionList::getInstance().scanPending(appId);
+    AppDescriptionList::getInstance().getByAppIds(appIds, appDescs, notExist);
+
+    JValue apps = pbnjson::Object();
+    for (AppDescriptionPtr appDesc : appDescs) {
+        JValue status = pbnjson::Object();
+        status.put("status", "launchable");
+        status.put("exist", true);
+        status.put("launchable", true);
+        if (appInfo)
+            status.put("appInfo", appDesc->getJson());
+        apps.put(appDesc->getAppId(), status);
+    }
+    for (const string& appId : notExist) {
+        JValue status = pbnjson::Object();
+        status.put("status", "notExist");
+        status.put("exist", false);
+        status.put("launchable", false);
+        apps.put(appId, status);
+    }
+    lunaTask->getResponsePayload().put("apps", apps);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::getMultipleAppInfo(LunaTaskPtr lunaTask)
+{
+    set<string> appIds;
+    getAppIds(lunaTask->getRequestPayload(), "ids", appIds);
+
+    JValue properties;
+    bool hasProperties = JValueUtil::getValue(lunaTask->getRequestPayload(), "properties", properties) && properties.isArray();
+
+    vector<AppDescriptionPtr> appDescs;
+    vector<string> notExist;
+    for (const string& appId : appIds)
+        AppDescriptionList::getInstance().scanPending(appId);
+    AppDescriptionList::getInstance().getByAppIds(appIds, appDescs, notExist);
+
+    JValue apps = pbnjson::Object();
+    for (AppDescriptionPtr appDesc : appDescs) {
+        if (hasProperties)
+            apps.put(appDesc->getAppId(), appDesc->getJson(properties));
+        else
+            apps.put(appDesc->getAppId(), appDesc->getJson());
+    }
+    JValue array;
+    toJsonArray(notExist, array);
+    lunaTask->getResponsePayload().put("appInfos", apps);
+    lunaTask->getResponsePayload().put("notExist", array);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::getCatalogStatus(LunaTaskPtr lunaTask)
+{
+    bool subscribed = false;
+
+    makeGetCatalogStatus(lunaTask->getResponsePayload());
+    if (lunaTask->getRequest().isSubscription()) {
+        subscribed = m_getCatalogStatus->subscribe(lunaTask->getRequest());
+    }
+    lunaTask->getResponsePayload().put("subscribed", subscribed);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::getHandlerForUrl(LunaTaskPtr lunaTask)
+{
+    string url = "";
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "url", url);
+
+    vector<string> appIds;
+    AppDescriptionList::getInstance().getHandlerTable().getHandlersForUrl(url, appIds);
+    if (appIds.empty()) {
+        lunaTask->setErrCodeAndText(ErrCode_GENERAL, "No handler for " + url);
+        LunaTaskList::getInstance().removeAfterReply(lunaTask);
+        return;
+    }
+    lunaTask->getResponsePayload().put("url", url);
+    lunaTask->getResponsePayload().put("appId", appIds.front());
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::getHandlerForMimeType(LunaTaskPtr lunaTask)
+{
+    string mimeType = "";
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "mimeType", mimeType);
+
+    vector<string> appIds;
+    AppDescriptionList::getInstance().getHandlerTable().getHandlersForMimeType(mimeType, appIds);
+    if (appIds.empty()) {
+        lunaTask->setErrCodeAndText(ErrCode_GENERAL, "No handler for " + mimeType);
+        LunaTaskList::getInstance().removeAfterReply(lunaTask);
+        return;
+    }
+    lunaTask->getResponsePayload().put("mimeType", mimeType);
+    lunaTask->getResponsePayload().put("appId", appIds.front());
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::getHandlerForExtension(LunaTaskPtr lunaTask)
+{
+    string extension = "";
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "extension", extension);
+
+    const HandlerTable& handlerTable = AppDescriptionList::getInstance().getHandlerTable();
+    vector<string> appIds;
+    handlerTable.getHandlersForExtension(extension, appIds);
+    if (appIds.empty()) {
+        lunaTask->setErrCodeAndText(ErrCode_GENERAL, "No handler for " + extension);
+        LunaTaskList::getInstance().removeAfterReply(lunaTask);
+        return;
+    }
+
+    string mimeType;
+    if (handlerTable.getMimeTypeForExtension(extension, mimeType))
+        lunaTask->getResponsePayload().put("mimeType", mimeType);
+    lunaTask->getResponsePayload().put("extension", extension);
+    lunaTask->getResponsePayload().put("appId", appIds.front());
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::listAllHandlersForUrl(LunaTaskPtr lunaTask)
+{
+    string url = "";
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "url", url);
+
+    vector<string> appIds;
+    AppDescriptionList::getInstance().getHandlerTable().getHandlersForUrl(url, appIds);
+
+    JValue array;
+    toJsonArray(appIds, array);
+    lunaTask->getResponsePayload().put("url", url);
+    lunaTask->getResponsePayload().put("appIds", array);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::listAllHandlersForUrlPattern(LunaTaskPtr lunaTask)
+{
+    string urlPattern = "";
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "urlPattern", urlPattern);
+
+    vector<string> appIds;
+    AppDescriptionList::getInstance().getHandlerTable().getHandlersForUrlPattern(urlPattern, appIds);
+
+    JValue array;
+    toJsonArray(appIds, array);
+    lunaTask->getResponsePayload().put("urlPattern", urlPattern);
+    lunaTask->getResponsePayload().put("appIds", array);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::listAllHandlersForMultipleUrlPattern(LunaTaskPtr lunaTask)
+{
+    JValue urls = pbnjson::Array();
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "urls", urls);
+
+    JValue handlers = pbnjson::Object();
+    for (int i = 0; i < urls.arraySize(); ++i) {
+        if (!urls[i].isString())
+            continue;
+        vector<string> appIds;
+        AppDescriptionList::getInstance().getHandlerTable().getHandlersForUrlPattern(urls[i].asString(), appIds);
+
+        JValue array;
+        toJsonArray(appIds, array);
+        handlers.put(urls[i].asString(), array);
+    }
+    lunaTask->getResponsePayload().put("handlers", handlers);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::listAllHandlersForMime(LunaTaskPtr lunaTask)
+{
+    string mime = "";
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "mime", mime);
+
+    vector<string> appIds;
+    AppDescriptionList::getInstance().getHandlerTable().getHandlersForMimeType(mime, appIds);
+
+    JValue array;
+    toJsonArray(appIds, array);
+    lunaTask->getResponsePayload().put("mime", mime);
+    lunaTask->getResponsePayload().put("appIds", array);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::listAllHandlersForMultipleMime(LunaTaskPtr lunaTask)
+{
+    JValue mimes = pbnjson::Array();
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "mimes", mimes);
+
+    JValue handlers = pbnjson::Object();
+    for (int i = 0; i < mimes.arraySize(); ++i) {
+        if (!mimes[i].isString())
+            continue;
+        vector<string> appIds;
+        AppDescriptionList::getInstance().getHandlerTable().getHandlersForMimeType(mimes[i].asString(), appIds);
+
+        JValue array;
+        toJsonArray(appIds, array);
+        handlers.put(mimes[i].asString(), array);
+    }
+    lunaTask->getResponsePayload().put("handlers", handlers);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::mimeTypeForExtension(LunaTaskPtr lunaTask)
+{
+    string extension = "";
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "extension", extension);
+
+    string mimeType;
+    if (!AppDescriptionList::getInstance().getHandlerTable().getMimeTypeForExtension(extension, mimeType)) {
+        lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Unknown extension " + extension);
+        LunaTaskList::getInstance().removeAfterReply(lunaTask);
+        return;
+    }
+    lunaTask->getResponsePayload().put("extension", extension);
+    lunaTask->getResponsePayload().put("mimeType", mimeType);
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
 void ApplicationManager::addLaunchPoint(LunaTaskPtr lunaTask)
 {
     const pbnjson::JValue& requestPayload = lunaTask->getRequestPayload();
@@ -567,6 +992,7 @@ void ApplicationManager::addLaunchPoint(LunaTaskPtr lunaTask)
         return;
     }
 
+    AppDescriptionList::getInstance().scanPending(lunaTask->getAppId());
     AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(lunaTask->getAppId());
     if (!appDesc) {
         lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Invalid appId specified OR Unsupported Application Type: " + lunaTask->getAppId());
@@ -627,11 +1053,38 @@ void ApplicationManager::removeLaunchPoint(LunaTaskPtr lunaTask)
 
 void ApplicationManager::listLaunchPoints(LunaTaskPtr lunaTask)
 {
+    int limit = 0;
+    string cursor = "";
+    bool stream = false;
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "limit", limit);
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "cursor", cursor);
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "stream", stream);
+    stream = stream && lunaTask->getRequest().isSubscription();
+    if (stream && limit <= 0)
+        limit = DEFAULT_PAGE_LIMIT;
+
     // Don't reply 'apps' in listApps during initializaion
-    if (m_enableSubscription) {
-        JValue launchPoints = pbnjson::Array();
-        LaunchPointList::getInstance().toJson(launchPoints);
-        lunaTask->getResponsePayload().put("launchPoints", launchPoints);
+    if (m_enableSubscription && limit <= 0 && cursor.empty()) {
+        string launchPoints;
+        LaunchPointList::getInstance().toJsonString(launchPoints);
+        lunaTask->putRawResponse("launchPoints", launchPoints);
+    } else if (m_enableSubscription) {
+        int generation = LaunchPointList::getInstance().getGeneration();
+        int offset = 0;
+        if (!parseCursor(cursor, generation, offset)) {
+            lunaTask->getResponsePayload().put("generation", generation);
+            lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Invalid or outdated cursor. Request from the first page");
+            LunaTaskList::getInstance().removeAfterReply(lunaTask);
+            return;
+        }
+        if (limit <= 0)
+            limit = DEFAULT_PAGE_LIMIT;
+        string launchPoints;
+        JValue properties = pbnjson::Array();
+        bool hasMore = makeListLaunchPointsPage(lunaTask->getResponsePayload(), launchPoints, offset, limit);
+        lunaTask->putRawResponse("launchPoints", launchPoints);
+        if (hasMore && stream)
+            addStream(lunaTask, false, properties, generation, offset + limit, limit);
     }
 
     if (lunaTask->getRequest().isSubscription())
@@ -641,6 +1094,106 @@ void ApplicationManager::listLaunchPoints(LunaTaskPtr lunaTask)
     LunaTaskList::getInstance().removeAfterReply(lunaTask);
 }
 
+gboolean ApplicationManager::onStream(gpointer context)
+{
+    ApplicationManager& self = ApplicationManager::getInstance();
+    // Catalog keeps changing while it is scanned. Streaming would be reset again and again.
+    if (self.m_streams.empty() || AppDescriptionList::getInstance().getScanStage() != ScanStage::ScanStage_Full) {
+        self.m_streamSourceId = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    // One page per idle so that other requests are not blocked by a long catalog
+    CatalogStream stream = self.m_streams.front();
+    self.m_streams.pop_front();
+
+    int generation = stream.isListApps ? AppDescriptionList::getInstance().getGeneration() : LaunchPointList::getInstance().getGeneration();
+    JValue payload = pbnjson::Object();
+    payload.put("returnValue", true);
+    payload.put("subscribed", true);
+    if (generation != stream.generation) {
+        // Catalog is changed in the middle of streaming. Client should drop previous pages.
+        payload.put("reset", true);
+        stream.generation = generation;
+        stream.offset = 0;
+    }
+
+    bool hasMore = false;
+    string items;
+    if (stream.isListApps)
+        hasMore = self.makeListAppsPage(payload, items, stream.properties, stream.isDevmode, stream.offset, stream.limit);
+    else
+        hasMore = self.makeListLaunchPointsPage(payload, items, stream.offset, stream.limit);
+    string serialized = payload.stringify();
+    JValueUtil::putRaw(serialized, stream.isListApps ? "apps" : "launchPoints", items);
+    stream.request.respond(serialized.c_str());
+
+    if (hasMore) {
+        stream.offset += stream.limit;
+        self.m_streams.push_back(stream);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+bool ApplicationManager::makeListAppsPage(JValue& payload, string& apps, JValue& properties, bool isDevmode, int offset, int limit)
+{
+    int generation = AppDescriptionList::getInstance().getGeneration();
+    bool hasMore = AppDescriptionList::getInstance().toJsonString(apps, properties, isDevmode, offset, limit);
+
+    payload.put("generation", generation);
+    if (hasMore)
+        payload.put("cursor", makeCursor(generation, offset + limit));
+    payload.put("done", !hasMore);
+    return hasMore;
+}
+
+bool ApplicationManager::makeListLaunchPointsPage(JValue& payload, string& launchPoints, int offset, int limit)
+{
+    int generation = LaunchPointList::getInstance().getGeneration();
+    bool hasMore = LaunchPointList::getInstance().toJsonString(launchPoints, offset, limit);
+
+    payload.put("generation", generation);
+    if (hasMore)
+        payload.put("cursor", makeCursor(generation, offset + limit));
+    payload.put("done", !hasMore);
+    return hasMore;
+}
+
+void ApplicationManager::addStream(LunaTaskPtr lunaTask, bool isListApps, JValue& properties, int generation, int offset, int limit)
+{
+    CatalogStream stream;
+    stream.request = lunaTask->getRequest();
+    stream.isListApps = isListApps;
+    stream.properties = properties.duplicate();
+    stream.isDevmode = lunaTask->isDevmodeRequest();
+    stream.generation = generation;
+    stream.offset = offset;
+    stream.limit = limit;
+    m_streams.push_back(stream);
+    resumeStreams();
+}
+
+void ApplicationManager::resumeStreams()
+{
+    if (m_streams.empty() || m_streamSourceId != 0)
+        return;
+    if (AppDescriptionList::getInstance().getScanStage() != ScanStage::ScanStage_Full)
+        return;
+    m_streamSourceId = g_idle_add(onStream, nullptr);
+}
+
+bool ApplicationManager::onCancelStream(LSHandle* sh, const char* uniqueToken, void* context)
+{
+    list<CatalogStream>& streams = ApplicationManager::getInstance().m_streams;
+    for (auto it = streams.begin(); it != streams.end();) {
+        if (strcmp(LSMessageGetUniqueToken(it->request.get()), uniqueToken) == 0)
+            it = streams.erase(it);
+        else
+            ++it;
+    }
+    return true;
+}
+
 void ApplicationManager::managerInfo(LunaTaskPtr lunaTask)
 {
     lunaTask->getResponsePayload().put("returnValue", true);
@@ -654,14 +1207,50 @@ void ApplicationManager::managerInfo(LunaTaskPtr lunaTask)
     LaunchPointList::getInstance().toJson(launchPoints);
     lunaTask->getResponsePayload().put("launchPoints", launchPoints);
 
+    bool resources = false;
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "resources", resources);
     pbnjson::JValue running = pbnjson::Array();
-    RunningAppList::getInstance().toJson(running);
+    RunningAppList::getInstance().toJson(running, false, resources);
     lunaTask->getResponsePayload().put("running", running);
 
     pbnjson::JValue lunaTasks = pbnjson::Array();
     LunaTaskList::getInstance().toJson(lunaTasks);
     lunaTask->getResponsePayload().put("lunaTasks", lunaTasks);
 
+    pbnjson::JValue memoryPolicy = pbnjson::Object();
+    MemoryPolicy::getInstance().toJson(memoryPolicy);
+    lunaTask->getResponsePayload().put("memoryPolicy", memoryPolicy);
+
+    LunaTaskList::getInstance().removeAfterReply(lunaTask);
+}
+
+void ApplicationManager::getAppOutput(LunaTaskPtr lunaTask)
+{
+    const string& appId = lunaTask->getAppId();
+    bool flush = false;
+    JValueUtil::getValue(lunaTask->getRequestPayload(), "flush", flush);
+
+    AppDescriptionList::getInstance().scanPending(appId);
+    AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
+    if (appDesc == nullptr || !appDesc->isDevmodeApp()) {
+        lunaTask->setErrCodeAndText(ErrCode_GENERAL, "Only output of Dev app is available");
+        LunaTaskList::getInstance().removeAfterReply(lunaTask);
+        return;
+    }
+
+    string output;
+    if (!OutputCapture::getInstance().getOutput(appId, output)) {
+        lunaTask->setErrCodeAndText(ErrCode_GENERAL, appId + " has no output");
+        LunaTaskList::getInstance().removeAfterReply(lunaTask);
+        return;
+    }
+
+    string path;
+    if (flush && OutputCapture::getInstance().flush(appId, path))
+        lunaTask->getResponsePayload().put("path", path);
+    lunaTask->getResponsePayload().put("appId", appId);
+    lunaTask->getResponsePayload().put("output", output);
+    lunaTask->getResponsePayload().put("returnValue", true);
     LunaTaskList::getInstance().removeAfterReply(lunaTask);
 }
 
@@ -743,8 +1332,13 @@ void ApplicationManager::postGetAppLifeEvents(RunningApp& runningApp)
         return;
     };
 
+    string event;
+    string payload = subscriptionPayload.stringify();
+    JValueUtil::getValue(subscriptionPayload, "event", event);
+
     Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getAppLifeEvents, subscriptionPayload);
-    m_getAppLifeEvents->post(subscriptionPayload.stringify().c_str());
+    m_getAppLifeEvents->post(payload.c_str());
+    postWithFilter(m_getAppLifeEventsFilters, runningApp, event, payload);
 }
 
 void ApplicationManager::postGetAppLifeStatus(RunningApp& runningApp)
@@ -795,8 +1389,37 @@ void ApplicationManager::postGetAppLifeStatus(RunningApp& runningApp)
         return;
     }
 
+    string payload = subscriptionPayload.stringify();
+
     Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getAppLifeStatus, subscriptionPayload);
-    m_getAppLifeStatus->post(subscriptionPayload.stringify().c_str());
+    m_getAppLifeStatus->post(payload.c_str());
+    postWithFilter(m_getAppLifeStatusFilters, runningApp, RunningApp::toString(runningApp.getLifeStatus()), payload);
+}
+
+bool ApplicationManager::subscribeWithFilter(LunaTaskPtr lunaTask, const string& key, map<string, SubscriptionFilter>& filters)
+{
+    if (!LSSubscriptionAdd(this->get(), key.c_str(), lunaTask->getMessage(), NULL)) {
+        if (LSSubscriptionGetHandleSubscribersCount(this->get(), key.c_str()) == 0)
+            filters.erase(key);
+        return false;
+    }
+    return true;
+}
+
+void ApplicationManager::postWithFilter(map<string, SubscriptionFilter>& filters, RunningApp& runningApp, const string& event, const string& payload)
+{
+    for (auto it = filters.begin(); it != filters.end();) {
+        if (LSSubscriptionGetHandleSubscribersCount(this->get(), it->first.c_str()) == 0) {
+            it = filters.erase(it);
+            continue;
+        }
+        if (it->second.isMatched(runningApp.getAppId(), runningApp.getDisplayId(), event)) {
+            if (!LSSubscriptionReply(this->get(), it->first.c_str(), payload.c_str(), NULL)) {
+                Logger::warning(getClassName(), __FUNCTION__, it->first, "Failed to post subscription");
+            }
+        }
+        ++it;
+    }
 }
 
 void ApplicationManager::postGetAppStatus(AppDescriptionPtr appDesc, AppStatusEvent event)
@@ -870,6 +1493,18 @@ void ApplicationManager::postGetForegroundAppInfo(bool isOverlayEvent)
     m_getForgroundAppInfoExtraInfo->post(subscriptionPayload.stringify().c_str());
 }
 
+void ApplicationManager::postGetCatalogStatus()
+{
+    // Not blocked by m_enableSubscription. Clients use this to start before listing is ready.
+    pbnjson::JValue subscriptionPayload = pbnjson::Object();
+    makeGetCatalogStatus(subscriptionPayload);
+    subscriptionPayload.put("returnValue", true);
+    subscriptionPayload.put("subscribed", true);
+
+    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_getCatalogStatus, subscriptionPayload);
+    m_getCatalogStatus->post(subscriptionPayload.stringify().c_str());
+}
+
 void ApplicationManager::postListApps(AppDescriptionPtr appDesc, const string& change, const string& changeReason)
 {
     if (!m_enableSubscription) return;
@@ -908,20 +1543,20 @@ void ApplicationManager::postListApps(AppDescriptionPtr appDesc, const string& c
             properties.append("id");
         }
 
+        string payload = subscriptionPayload.stringify();
         if (appDesc == nullptr) {
-            pbnjson::JValue apps = pbnjson::Array();
-            AppDescriptionList::getInstance().toJson(apps, properties, isDevmode);
-            subscriptionPayload.put("apps", apps);
+            string apps;
+            AppDescriptionList::getInstance().toJsonString(apps, properties, isDevmode);
+            JValueUtil::putRaw(payload, "apps", apps);
         } else {
             if (appDesc->isDevmodeApp() != isDevmode) {
                 Logger::debug(getClassName(), __FUNCTION__, "Devmode != DevmodeApp");
                 continue;
             }
-            pbnjson::JValue app = appDesc->getJson(properties);
-            subscriptionPayload.put("app", app);
+            JValueUtil::putRaw(payload, "app", appDesc->getJsonString(properties));
         }
         Logger::debug(getClassName(), __FUNCTION__, request.getSenderServiceName());
-        request.respond(subscriptionPayload.stringify().c_str());
+        request.respond(payload.c_str());
     }
     LSSubscriptionRelease(iter);
     iter = NULL;
@@ -935,23 +1570,21 @@ void ApplicationManager::postListLaunchPoints(LaunchPointPtr launchPoint, string
         return;
 
     pbnjson::JValue subscriptionPayload = pbnjson::Object();
-    pbnjson::JValue json = pbnjson::Object();
-
-    if (launchPoint) {
-        launchPoint->toJson(json);
-        subscriptionPayload.put("launchPoint", json);
-    } else {
-        pbnjson::JValue launchPoints = pbnjson::Array();
-        LaunchPointList::getInstance().toJson(launchPoints);
-    }
-
     subscriptionPayload.put("subscribed", true);
     subscriptionPayload.put("returnValue", true);
     if (!change.empty())
         subscriptionPayload.put("change", change);
 
-    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_listLaunchPointsPoint, subscriptionPayload);
-    m_listLaunchPointsPoint->post(subscriptionPayload.stringify().c_str());
+    string payload = subscriptionPayload.stringify();
+    if (launchPoint) {
+        JValueUtil::putRaw(payload, "launchPoint", launchPoint->toJsonString());
+    } else {
+        string launchPoints;
+        LaunchPointList::getInstance().toJsonString(launchPoints);
+        JValueUtil::putRaw(payload, "launchPoints", launchPoints);
+    }
+    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_listLaunchPointsPoint, payload);
+    m_listLaunchPointsPoint->post(payload.c_str());
 }
 
 void ApplicationManager::postRunning(RunningAppPtr runningApp)
@@ -961,6 +1594,7 @@ void ApplicationManager::postRunning(RunningAppPtr runningApp)
 
     if (!m_enableSubscription) return;
 
+    bool isChanged = false;
     pbnjson::JValue subscriptionPayload;
     if (runningApp != nullptr && runningApp->getLaunchPoint()->getAppDesc()->isDevmodeApp()) {
         if (RunningAppList::getInstance().isTransition(true))
@@ -974,21 +1608,51 @@ void ApplicationManager::postRunning(RunningAppPtr runningApp)
             prevSubscriptionPayloadDev = subscriptionPayload.duplicate();
             Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_runningDev, subscriptionPayload);
             m_runningDev->post(subscriptionPayload.stringify().c_str());
+            isChanged = true;
         }
     }
 
-    if (RunningAppList::getInstance().isTransition(false))
-        return;
+    if (!RunningAppList::getInstance().isTransition(false)) {
+        subscriptionPayload = pbnjson::Object();
+        makeRunning(subscriptionPayload, false);
+        subscriptionPayload.put("subscribed", true);
+        subscriptionPayload.put("returnValue", true);
 
-    subscriptionPayload = pbnjson::Object();
-    makeRunning(subscriptionPayload, false);
-    subscriptionPayload.put("subscribed", true);
-    subscriptionPayload.put("returnValue", true);
+        if (subscriptionPayload != prevSubscriptionPayloadAll) {
+            prevSubscriptionPayloadAll = subscriptionPayload.duplicate();
+            Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_running, subscriptionPayload);
+            m_running->post(subscriptionPayload.stringify().c_str());
+            isChanged = true;
+        }
+    }
+
+    // Subscribers with resources also need launched and closed apps between samples
+    if (isChanged)
+        postRunningResources();
+}
+
+void ApplicationManager::postRunningResources()
+{
+    if (!m_enableSubscription) return;
+
+    pbnjson::JValue subscriptionPayload;
+    if (m_runningResourcesDev->getSubscribersCount() > 0) {
+        subscriptionPayload = pbnjson::Object();
+        makeRunning(subscriptionPayload, true, true);
+        subscriptionPayload.put("subscribed", true);
+        subscriptionPayload.put("returnValue", true);
+        Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_runningResourcesDev, subscriptionPayload);
+        m_runningResourcesDev->post(subscriptionPayload.stringify().c_str());
+    }
 
-    if (subscriptionPayload == prevSubscriptionPayloadAll) return;
-    prevSubscriptionPayloadAll = subscriptionPayload.duplicate();
-    Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_running, subscriptionPayload);
-    m_running->post(subscriptionPayload.stringify().c_str());
+    if (m_runningResources->getSubscribersCount() > 0) {
+        subscriptionPayload = pbnjson::Object();
+        makeRunning(subscriptionPayload, false, true);
+        subscriptionPayload.put("subscribed", true);
+        subscriptionPayload.put("returnValue", true);
+        Logger::logSubscriptionPost(getClassName(), __FUNCTION__, *m_runningResources, subscriptionPayload);
+        m_runningResources->post(subscriptionPayload.stringify().c_str());
+    }
 }
 
 void ApplicationManager::makeGetForegroundAppInfo(JValue& payload)
@@ -1009,9 +1673,18 @@ void ApplicationManager::makeGetForegroundAppInfo(JValue& payload)
     }
 }
 
-void ApplicationManager::makeRunning(JValue& payload, bool isDevmode)
+void ApplicationManager::makeGetCatalogStatus(JValue& payload)
+{
+    // 'critical' : Critical apps can be launched
+    // 'full'     : Whole catalog is scanned. Launch points are being restored.
+    // listReady  : listApps and listLaunchPoints reply items
+    payload.put("stage", AppDescriptionList::toString(AppDescriptionList::getInstance().getScanStage()));
+    payload.put("listReady", m_enableSubscription);
+}
+
+void ApplicationManager::makeRunning(JValue& payload, bool isDevmode, bool withResources)
 {
     pbnjson::JValue running = pbnjson::Array();
-    RunningAppList::getInstance().toJson(running, isDevmode);
+    RunningAppList::getInstance().toJson(running, isDevmode, withResources);
     payload.put("running", running);
 }
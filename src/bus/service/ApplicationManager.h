@@ -17,6 +17,7 @@
 #ifndef BUS_SERVICE_APPLICATIONMANAGER_H_
 #define BUS_SERVICE_APPLICATIONMANAGER_H_
 
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -31,6 +32,7 @@
 #include "base/LaunchPointList.h"
 #include "base/RunningApp.h"
 #include "base/RunningAppList.h"
+#include "bus/service/SubscriptionFilter.h"
 #include "bus/service/compat/ApplicationManagerCompat.h"
 #include "conf/SAMConf.h"
 #include "interface/IClassName.h"
@@ -63,9 +65,23 @@ public:
     static const char* METHOD_REGISTER_NATIVE_APP;
 
     static const char* METHOD_LIST_APPS;
+    static const char* METHOD_SEARCH_APPS;
     static const char* METHOD_GET_APP_STATUS;
     static const char* METHOD_GET_APP_INFO;
     static const char* METHOD_GET_APP_BASE_PATH;
+    static const char* METHOD_GET_MULTIPLE_APP_STATUS;
+    static const char* METHOD_GET_MULTIPLE_APP_INFO;
+    static const char* METHOD_GET_CATALOG_STATUS;
+
+    static const char* METHOD_GET_HANDLER_FOR_URL;
+    static const char* METHOD_GET_HANDLER_FOR_MIME_TYPE;
+    static const char* METHOD_GET_HANDLER_FOR_EXTENSION;
+    static const char* METHOD_LIST_ALL_HANDLERS_FOR_URL;
+    static const char* METHOD_LIST_ALL_HANDLERS_FOR_URL_PATTERN;
+    static const char* METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_URL_PATTERN;
+    static const char* METHOD_LIST_ALL_HANDLERS_FOR_MIME;
+    static const char* METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_MIME;
+    static const char* METHOD_MIME_TYPE_FOR_EXTENSION;
 
     static const char* METHOD_ADD_LAUNCHPOINT;
     static const char* METHOD_UPDATE_LAUNCHPOINT;
@@ -73,6 +89,7 @@ public:
     static const char* METHOD_LIST_LAUNCHPOINTS;
 
     static const char* METHOD_MANAGER_INFO;
+    static const char* METHOD_GET_APP_OUTPUT;
 
     virtual ~ApplicationManager();
 
@@ -91,9 +108,23 @@ public:
     void registerApp(LunaTaskPtr lunaTask);
 
     void listApps(LunaTaskPtr lunaTask);
+    void searchApps(LunaTaskPtr lunaTask);
     void getAppStatus(LunaTaskPtr lunaTask);
     void getAppInfo(LunaTaskPtr lunaTask);
     void getAppBasePath(LunaTaskPtr lunaTask);
+    void getMultipleAppStatus(LunaTaskPtr lunaTask);
+    void getMultipleAppInfo(LunaTaskPtr lunaTask);
+    void getCatalogStatus(LunaTaskPtr lunaTask);
+
+    void getHandlerForUrl(LunaTaskPtr lunaTask);
+    void getHandlerForMimeType(LunaTaskPtr lunaTask);
+    void getHandlerForExtension(LunaTaskPtr lunaTask);
+    void listAllHandlersForUrl(LunaTaskPtr lunaTask);
+    void listAllHandlersForUrlPattern(LunaTaskPtr lunaTask);
+    void listAllHandlersForMultipleUrlPattern(LunaTaskPtr lunaTask);
+    void listAllHandlersForMime(LunaTaskPtr lunaTask);
+    void listAllHandlersForMultipleMime(LunaTaskPtr lunaTask);
+    void mimeTypeForExtension(LunaTaskPtr lunaTask);
 
     void addLaunchPoint(LunaTaskPtr lunaTask);
     void updateLaunchPoint(LunaTaskPtr lunaTask);
@@ -101,19 +132,25 @@ public:
     void listLaunchPoints(LunaTaskPtr lunaTask);
 
     void managerInfo(LunaTaskPtr lunaTask);
+    void getAppOutput(LunaTaskPtr lunaTask);
 
     // Post
     void postGetAppLifeEvents(RunningApp& runningApp);
     void postGetAppLifeStatus(RunningApp& runningApp);
     void postGetAppStatus(AppDescriptionPtr appDesc, AppStatusEvent event);
     void postGetForegroundAppInfo(bool isOverlayEvent);
+    void postGetCatalogStatus();
     void postListApps(AppDescriptionPtr appDesc, const string& change, const string& changeReason);
     void postListLaunchPoints(LaunchPointPtr launchPoint, string change);
     void postRunning(RunningAppPtr runningApp);
+    void postRunningResources();
+    // Streams are paused until whole catalog is scanned. Called when it is done.
+    void resumeStreams();
 
     // make
     void makeGetForegroundAppInfo(JValue& payload);
-    void makeRunning(JValue& payload, bool isDevmode);
+    void makeGetCatalogStatus(JValue& payload);
+    void makeRunning(JValue& payload, bool isDevmode, bool withResources = false);
 
     void enablePosting()
     {
@@ -133,7 +170,20 @@ public:
     }
 
 private:
+    // Remaining pages of 'listApps' or 'listLaunchPoints' with 'stream'
+    struct CatalogStream {
+        LS::Message request;
+        bool isListApps;
+        JValue properties;
+        bool isDevmode;
+        int generation;
+        int offset;
+        int limit;
+    };
+
     static bool onAPICalled(LSHandle* sh, LSMessage* message, void* context);
+    static gboolean onStream(gpointer context);
+    static bool onCancelStream(LSHandle* sh, const char* uniqueToken, void* context);
 
     ApplicationManager();
 
@@ -143,6 +193,14 @@ private:
         m_APIHandlers[api] = handler;
     }
 
+    // Returns true if more items are left after the page
+    bool makeListAppsPage(JValue& payload, string& apps, JValue& properties, bool isDevmode, int offset, int limit);
+    bool makeListLaunchPointsPage(JValue& payload, string& launchPoints, int offset, int limit);
+    void addStream(LunaTaskPtr lunaTask, bool isListApps, JValue& properties, int generation, int offset, int limit);
+
+    bool subscribeWithFilter(LunaTaskPtr lunaTask, const string& key, map<string, SubscriptionFilter>& filters);
+    void postWithFilter(map<string, SubscriptionFilter>& filters, RunningApp& runningApp, const string& event, const string& payload);
+
     static LSMethod METHODS_ROOT[];
     static LSMethod METHODS_DEV[];
 
@@ -152,6 +210,7 @@ private:
     LS::SubscriptionPoint* m_getAppLifeStatus;
     LS::SubscriptionPoint* m_getForgroundAppInfo;
     LS::SubscriptionPoint* m_getForgroundAppInfoExtraInfo;
+    LS::SubscriptionPoint* m_getCatalogStatus;
     LS::SubscriptionPoint* m_listLaunchPointsPoint;
     LS::SubscriptionPoint* m_listAppsPoint;
     LS::SubscriptionPoint* m_listAppsCompactPoint;
@@ -159,9 +218,18 @@ private:
     LS::SubscriptionPoint* m_listDevAppsCompactPoint;
     LS::SubscriptionPoint* m_running;
     LS::SubscriptionPoint* m_runningDev;
+    LS::SubscriptionPoint* m_runningResources;
+    LS::SubscriptionPoint* m_runningResourcesDev;
+
+    // subscription key => filter
+    map<string, SubscriptionFilter> m_getAppLifeEventsFilters;
+    map<string, SubscriptionFilter> m_getAppLifeStatusFilters;
 
     bool m_enableSubscription;
 
+    list<CatalogStream> m_streams;
+    guint m_streamSourceId;
+
     // TODO: Following should be deleted
     ApplicationManagerCompat m_compat1;
     ApplicationManagerCompat m_compat2;
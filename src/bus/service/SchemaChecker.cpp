@@ -26,19 +26,33 @@ SchemaChecker::SchemaChecker()
     m_APISchemaFiles[ApplicationManager::METHOD_CLOSE] = "";
     m_APISchemaFiles[ApplicationManager::METHOD_CLOSE_BY_APPID] = "applicationManager.closeByAppId";
     m_APISchemaFiles[ApplicationManager::METHOD_RUNNING] = "applicationManager.running";
-    m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_LIFE_EVENTS] = "";
-    m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_LIFE_STATUS] = "";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_LIFE_EVENTS] = "applicationManager.getAppLifeEvents";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_LIFE_STATUS] = "applicationManager.getAppLifeStatus";
     m_APISchemaFiles[ApplicationManager::METHOD_GET_FOREGROUND_APPINFO] = "applicationManager.getForegroundAppInfo";
     m_APISchemaFiles[ApplicationManager::METHOD_LOCK_APP] = "applicationManager.lockApp";
     m_APISchemaFiles[ApplicationManager::METHOD_REGISTER_APP] = "";
     m_APISchemaFiles[ApplicationManager::METHOD_LIST_APPS] = "applicationManager.listApps";
+    m_APISchemaFiles[ApplicationManager::METHOD_SEARCH_APPS] = "applicationManager.searchApps";
     m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_STATUS] = "applicationManager.getAppStatus";
     m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_INFO] = "applicationManager.getAppInfo";
     m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_BASE_PATH] = "applicationManager.getAppBasePath";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_MULTIPLE_APP_STATUS] = "applicationManager.getMultipleAppStatus";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_MULTIPLE_APP_INFO] = "applicationManager.getMultipleAppInfo";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_CATALOG_STATUS] = "applicationManager.getCatalogStatus";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_HANDLER_FOR_URL] = "applicationManager.getHandlerForUrl";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_HANDLER_FOR_MIME_TYPE] = "applicationManager.getHandlerForMimeType";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_HANDLER_FOR_EXTENSION] = "applicationManager.getHandlerForExtension";
+    m_APISchemaFiles[ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_URL] = "applicationManager.listAllHandlersForUrl";
+    m_APISchemaFiles[ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_URL_PATTERN] = "applicationManager.listAllHandlersForUrlPattern";
+    m_APISchemaFiles[ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_URL_PATTERN] = "applicationManager.listAllHandlersForMultipleUrlPattern";
+    m_APISchemaFiles[ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_MIME] = "applicationManager.listAllHandlersForMime";
+    m_APISchemaFiles[ApplicationManager::METHOD_LIST_ALL_HANDLERS_FOR_MULTIPLE_MIME] = "applicationManager.listAllHandlersForMultipleMime";
+    m_APISchemaFiles[ApplicationManager::METHOD_MIME_TYPE_FOR_EXTENSION] = "applicationManager.mimeTypeForExtension";
     m_APISchemaFiles[ApplicationManager::METHOD_ADD_LAUNCHPOINT] = "applicationManager.addLaunchPoint";
     m_APISchemaFiles[ApplicationManager::METHOD_UPDATE_LAUNCHPOINT] = "applicationManager.updateLaunchPoint";
     m_APISchemaFiles[ApplicationManager::METHOD_REMOVE_LAUNCHPOINT] = "applicationManager.removeLaunchPoint";
     m_APISchemaFiles[ApplicationManager::METHOD_LIST_LAUNCHPOINTS] = "applicationManager.listLaunchPoints";
+    m_APISchemaFiles[ApplicationManager::METHOD_GET_APP_OUTPUT] = "applicationManager.getAppOutput";
 }
 
 SchemaChecker::~SchemaChecker()
@@ -0,0 +1,74 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SubscriptionFilter.h"
+
+#include "util/JValueUtil.h"
+
+SubscriptionFilter::SubscriptionFilter()
+    : m_displayId(-1)
+{
+}
+
+SubscriptionFilter::~SubscriptionFilter()
+{
+}
+
+bool SubscriptionFilter::parse(const JValue& requestPayload)
+{
+    JValue appIds;
+    JValue events;
+
+    if (JValueUtil::getValue(requestPayload, "appIds", appIds) && appIds.isArray()) {
+        for (int i = 0; i < appIds.arraySize(); ++i) {
+            m_appIds.insert(appIds[i].asString());
+        }
+    }
+    if (JValueUtil::getValue(requestPayload, "events", events) && events.isArray()) {
+        for (int i = 0; i < events.arraySize(); ++i) {
+            m_events.insert(events[i].asString());
+        }
+    }
+    JValueUtil::getValue(requestPayload, "displayId", m_displayId);
+
+    return !m_appIds.empty() || !m_events.empty() || m_displayId >= 0;
+}
+
+bool SubscriptionFilter::isMatched(const string& appId, int displayId, const string& event) const
+{
+    if (!m_appIds.empty() && m_appIds.find(appId) == m_appIds.end())
+        return false;
+    if (!m_events.empty() && m_events.find(event) == m_events.end())
+        return false;
+    if (m_displayId >= 0 && m_displayId != displayId)
+        return false;
+    return true;
+}
+
+string SubscriptionFilter::getKey(const string& method) const
+{
+    // std::set is sorted. Same filter in different order makes same key.
+    string key = method + "#";
+    for (const string& appId : m_appIds) {
+        key += appId + ",";
+    }
+    key += "#";
+    for (const string& event : m_events) {
+        key += event + ",";
+    }
+    key += "#" + to_string(m_displayId);
+    return key;
+}
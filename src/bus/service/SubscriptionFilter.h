@@ -0,0 +1,46 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BUS_SERVICE_SUBSCRIPTIONFILTER_H_
+#define BUS_SERVICE_SUBSCRIPTIONFILTER_H_
+
+#include <iostream>
+#include <set>
+#include <pbnjson.hpp>
+
+using namespace std;
+using namespace pbnjson;
+
+// Optional 'appIds', 'events' and 'displayId' in subscription request.
+// Subscribers with same filter share one subscription key.
+class SubscriptionFilter {
+public:
+    SubscriptionFilter();
+    virtual ~SubscriptionFilter();
+
+    // Returns false if the request doesn't have any filter
+    bool parse(const JValue& requestPayload);
+    bool isMatched(const string& appId, int displayId, const string& event) const;
+
+    string getKey(const string& method) const;
+
+private:
+    set<string> m_appIds;
+    set<string> m_events;
+    int m_displayId;
+};
+
+#endif /* BUS_SERVICE_SUBSCRIPTIONFILTER_H_ */
@@ -0,0 +1,171 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LaunchPointStore.h"
+
+#include "RuntimeInfo.h"
+#include "base/AppDescriptionList.h"
+#include "base/LaunchPointList.h"
+#include "util/File.h"
+#include "util/JValueUtil.h"
+#include "util/Logger.h"
+#include "util/MappedFile.h"
+
+LaunchPointStore::LaunchPointStore()
+    : m_isLoading(false),
+      m_isDirty(false),
+      m_saveSourceId(0)
+{
+    setClassName("LaunchPointStore");
+}
+
+LaunchPointStore::~LaunchPointStore()
+{
+}
+
+void LaunchPointStore::initialize()
+{
+    load();
+}
+
+void LaunchPointStore::finalize()
+{
+    sync();
+}
+
+void LaunchPointStore::markDirty()
+{
+    if (m_isLoading)
+        return;
+
+    m_isDirty = true;
+    if (m_saveSourceId != 0)
+        return;
+    m_saveSourceId = g_idle_add_full(G_PRIORITY_LOW, onSave, nullptr, nullptr);
+}
+
+void LaunchPointStore::sync()
+{
+    if (m_saveSourceId != 0) {
+        g_source_remove(m_saveSourceId);
+        m_saveSourceId = 0;
+    }
+    if (!m_isDirty)
+        return;
+    save();
+}
+
+void LaunchPointStore::reconcile(const set<string>& launchPointIds)
+{
+    for (const string& launchPointId : m_loadedLaunchPointIds) {
+        if (launchPointIds.find(launchPointId) != launchPointIds.end())
+            continue;
+
+        LaunchPointPtr launchPoint = LaunchPointList::getInstance().getByLaunchPointId(launchPointId);
+        if (launchPoint == nullptr)
+            continue;
+
+        Logger::info(getClassName(), __FUNCTION__, launchPointId, "Not in DB8. Drop it");
+        if (launchPoint->getType() == LaunchPointType::LaunchPoint_BOOKMARK) {
+            LaunchPointList::getInstance().remove(launchPoint);
+        } else {
+            launchPoint->setDatabase(pbnjson::Object());
+        }
+    }
+    m_loadedLaunchPointIds.clear();
+}
+
+gboolean LaunchPointStore::onSave(gpointer context)
+{
+    LaunchPointStore::getInstance().m_saveSourceId = 0;
+    if (LaunchPointStore::getInstance().m_isDirty)
+        LaunchPointStore::getInstance().save();
+    return G_SOURCE_REMOVE;
+}
+
+bool LaunchPointStore::load()
+{
+    string path = getPath();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        Logger::info(getClassName(), __FUNCTION__, path, "No snapshot. Wait for DB8");
+        return false;
+    }
+
+    // Parse mapped snapshot in place without copying it
+    JValue records = JDomParser::fromString(JInput(file.getData(), file.getSize()));
+    if (!records.isArray()) {
+        Logger::warning(getClassName(), __FUNCTION__, path, "Failed to parse snapshot");
+        return false;
+    }
+
+    m_isLoading = true;
+    int size = records.arraySize();
+    for (int i = 0; i < size; ++i) {
+        string appId;
+        string launchPointId;
+        string type;
+
+        if (!JValueUtil::getValue(records[i], "id", appId) ||
+            !JValueUtil::getValue(records[i], "launchPointId", launchPointId) ||
+            !JValueUtil::getValue(records[i], "type", type)) {
+            continue;
+        }
+
+        AppDescriptionPtr appDesc = AppDescriptionList::getInstance().getByAppId(appId);
+        if (appDesc == nullptr)
+            continue;
+
+        LaunchPointPtr launchPoint = LaunchPointList::getInstance().getByLaunchPointId(launchPointId);
+        if (type == "default" && launchPoint != nullptr) {
+            launchPoint->setDatabase(records[i]);
+        } else if (type == "bookmark" && launchPoint == nullptr) {
+            launchPoint = LaunchPointList::getInstance().createBootmarkByDB(appDesc, records[i]);
+            if (!LaunchPointList::getInstance().restore(launchPoint))
+                continue;
+        } else {
+            continue;
+        }
+        m_loadedLaunchPointIds.insert(launchPointId);
+    }
+    m_isLoading = false;
+
+    Logger::info(getClassName(), __FUNCTION__, path, Logger::format("Loaded %d of %d records", (int)m_loadedLaunchPointIds.size(), size));
+    return true;
+}
+
+bool LaunchPointStore::save()
+{
+    string path = getPath();
+
+    JValue records = pbnjson::Array();
+    LaunchPointList::getInstance().toDatabaseJson(records);
+    if (!File::writeFileAtomically(path, records.stringify())) {
+        Logger::warning(getClassName(), __FUNCTION__, path, "Failed to save snapshot");
+        return false;
+    }
+    m_isDirty = false;
+    return true;
+}
+
+string LaunchPointStore::getPath()
+{
+    if (!RuntimeInfo::getInstance().getHome().empty()) {
+        return RuntimeInfo::getInstance().getHome() + "/.config/sam-launchpoints.json";
+    }
+    return PATH_LAUNCH_POINT_STORE;
+}
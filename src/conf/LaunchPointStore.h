@@ -0,0 +1,66 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CONF_LAUNCHPOINTSTORE_H_
+#define CONF_LAUNCHPOINTSTORE_H_
+
+#include <iostream>
+#include <set>
+#include <glib.h>
+#include <pbnjson.hpp>
+
+#include "Environment.h"
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+using namespace pbnjson;
+
+// Local snapshot of launchPoint records in DB8.
+// It makes bookmarks and customized launchPoints available before DB8 is connected.
+class LaunchPointStore : public ISingleton<LaunchPointStore>,
+                         public IClassName {
+friend class ISingleton<LaunchPointStore> ;
+public:
+    virtual ~LaunchPointStore();
+
+    void initialize();
+    void finalize();
+
+    void markDirty();
+    void sync();
+
+    // DB8 is the origin of records. Records which are only in snapshot are dropped.
+    void reconcile(const set<string>& launchPointIds);
+
+private:
+    static gboolean onSave(gpointer context);
+
+    LaunchPointStore();
+
+    bool load();
+    bool save();
+
+    string getPath();
+
+    set<string> m_loadedLaunchPointIds;
+
+    bool m_isLoading;
+    bool m_isDirty;
+    guint m_saveSourceId;
+};
+
+#endif /* CONF_LAUNCHPOINTSTORE_H_ */
@@ -84,7 +84,7 @@ bool RuntimeInfo::save()
 
 bool RuntimeInfo::load()
 {
-    m_database = JDomParser::fromFile(PATH_RUNTIME_INFO);
+    m_database = JValueUtil::parseFile(PATH_RUNTIME_INFO);
     if (m_database.isNull()) {
         m_database = pbnjson::Object();
         save();
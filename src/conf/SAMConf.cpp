@@ -21,7 +21,10 @@
 SAMConf::SAMConf()
     : m_isRespawned(false),
       m_isDevmodeEnabled(false),
-      m_isJailerDisabled(true)
+      m_isJailerDisabled(true),
+      m_isReadWriteConfDirty(false),
+      m_flushSourceId(0),
+      m_flushCount(0)
 {
     setClassName("Settings");
 }
@@ -56,9 +59,33 @@ void SAMConf::initialize()
                  Logger::toString(m_isDevmodeEnabled), Logger::toString(m_isRespawned), Logger::toString(m_isJailerDisabled)));
 }
 
+void SAMConf::finalize()
+{
+    sync();
+}
+
+void SAMConf::sync()
+{
+    if (m_flushSourceId != 0) {
+        g_source_remove(m_flushSourceId);
+        m_flushSourceId = 0;
+    }
+    if (!m_isReadWriteConfDirty)
+        return;
+    saveReadWriteConf();
+}
+
+gboolean SAMConf::onFlushReadWriteConf(gpointer context)
+{
+    SAMConf::getInstance().m_flushSourceId = 0;
+    if (SAMConf::getInstance().m_isReadWriteConfDirty)
+        SAMConf::getInstance().saveReadWriteConf();
+    return G_SOURCE_REMOVE;
+}
+
 void SAMConf::loadReadOnlyConf()
 {
-    m_readOnlyDatabase = JDomParser::fromFile(PATH_RO_SAM_CONF, JValueUtil::getSchema("sam-conf"));
+    m_readOnlyDatabase = JValueUtil::parseFile(PATH_RO_SAM_CONF, JValueUtil::getSchema("sam-conf"));
     if (m_readOnlyDatabase.isNull()) {
         Logger::warning(getClassName(), __FUNCTION__, PATH_RO_SAM_CONF, "Failed to parse read-only sam-conf");
     }
@@ -66,16 +93,12 @@ void SAMConf::loadReadOnlyConf()
 
 void SAMConf::loadReadWriteConf()
 {
-    string path = "";
-
     if (!RuntimeInfo::getInstance().getHome().empty()) {
-        path = RuntimeInfo::getInstance().getHome() + "/.config";
-        File::makeDirectory(path);
-        path += "/sam-conf.json";
-    } else {
-        path = PATH_RW_SAM_CONF;
+        File::makeDirectory(RuntimeInfo::getInstance().getHome() + "/.config");
     }
-    m_readWriteDatabase = JDomParser::fromFile(path.c_str());
+
+    string path = getReadWriteConfPath();
+    m_readWriteDatabase = JValueUtil::parseFile(path);
     if (m_readWriteDatabase.isNull()) {
         m_readWriteDatabase = pbnjson::Object();
         saveReadWriteConf();
@@ -84,22 +107,39 @@ void SAMConf::loadReadWriteConf()
 
 void SAMConf::saveReadWriteConf()
 {
-    string path = "";
+    string path = getReadWriteConfPath();
 
-    if (!RuntimeInfo::getInstance().getHome().empty()) {
-        path = RuntimeInfo::getInstance().getHome() + "/.config/sam-conf.json";
-    } else {
-        path = PATH_RW_SAM_CONF;
+    // Keep dirty flag on failure. Next change will retry it.
+    if (!File::writeFileAtomically(path, m_readWriteDatabase.stringify("    "))) {
+        Logger::warning(getClassName(), __FUNCTION__, path, "Failed to save read-write sam-conf");
+        return;
     }
+    m_isReadWriteConfDirty = false;
+    m_flushCount++;
+    Logger::debug(getClassName(), __FUNCTION__, path, Logger::format("flushCount(%u)", m_flushCount));
+}
+
+void SAMConf::markReadWriteConfDirty()
+{
+    m_isReadWriteConfDirty = true;
+    if (m_flushSourceId != 0)
+        return;
+
+    // Changes made until main loop becomes idle are written at once
+    m_flushSourceId = g_idle_add_full(G_PRIORITY_LOW, onFlushReadWriteConf, nullptr, nullptr);
+}
 
-    if (!File::writeFile(path, m_readWriteDatabase.stringify("    ").c_str())) {
-        Logger::warning(getClassName(), __FUNCTION__, PATH_RO_SAM_CONF, "Failed to save read-write sam-conf");
+string SAMConf::getReadWriteConfPath()
+{
+    if (!RuntimeInfo::getInstance().getHome().empty()) {
+        return RuntimeInfo::getInstance().getHome() + "/.config/sam-conf.json";
     }
+    return PATH_RW_SAM_CONF;
 }
 
 void SAMConf::loadBlockedList()
 {
-    m_blockedListDatabase = JDomParser::fromFile(PATH_BLOCKED_LIST);
+    m_blockedListDatabase = JValueUtil::parseFile(PATH_BLOCKED_LIST);
     if (m_blockedListDatabase.isNull()) {
         Logger::warning(getClassName(), __FUNCTION__, PATH_RO_SAM_CONF, "Failed to parse blocked-file sam-conf");
     }
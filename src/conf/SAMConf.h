@@ -18,6 +18,7 @@
 #define __CONF_SAM_FONF_H__
 
 #include <string>
+#include <glib.h>
 #include <pbnjson.hpp>
 
 #include "Environment.h"
@@ -34,6 +35,15 @@ public:
     virtual ~SAMConf();
 
     void initialize();
+    void finalize();
+
+    // Writes pending read-write changes to disk immediately
+    void sync();
+
+    unsigned int getFlushCount() const
+    {
+        return m_flushCount;
+    }
 
     /** READ ONLY CONFIGS **/
 
@@ -51,6 +61,13 @@ public:
         return AppShellRunnerPath;
     }
 
+    JValue getBackgroundBudget() const
+    {
+        JValue BackgroundBudget = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "BackgroundBudget", BackgroundBudget);
+        return BackgroundBudget;
+    }
+
     JValue getDBPermission() const
     {
         JValue LaunchPointDBPermissions = pbnjson::Object();
@@ -86,6 +103,55 @@ public:
         return JailModePath;
     }
 
+    JValue getLifeCycleTimeout() const
+    {
+        JValue LifeCycleTimeout = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "LifeCycleTimeout", LifeCycleTimeout);
+        return LifeCycleTimeout;
+    }
+
+    JValue getMemoryPressure() const
+    {
+        JValue MemoryPressure = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "MemoryPressure", MemoryPressure);
+        return MemoryPressure;
+    }
+
+    JValue getNativeOutput() const
+    {
+        JValue NativeOutput = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "NativeOutput", NativeOutput);
+        return NativeOutput;
+    }
+
+    JValue getStagedBoot() const
+    {
+        JValue StagedBoot = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "StagedBoot", StagedBoot);
+        return StagedBoot;
+    }
+
+    JValue getPrewarm() const
+    {
+        JValue Prewarm = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "Prewarm", Prewarm);
+        return Prewarm;
+    }
+
+    const string& getNativeCgroupPath()
+    {
+        static string NativeCgroupPath = "";
+        JValueUtil::getValue(m_readOnlyDatabase, "NativeCgroupPath", NativeCgroupPath);
+        return NativeCgroupPath;
+    }
+
+    JValue getOOMScoreAdj() const
+    {
+        JValue OOMScoreAdj = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "OOMScoreAdj", OOMScoreAdj);
+        return OOMScoreAdj;
+    }
+
     const string& getQmlRunnerPath()
     {
         static string QmlRunnerPath = "/usr/bin/qml-runner";
@@ -93,6 +159,22 @@ public:
         return QmlRunnerPath;
     }
 
+    // milliseconds. 0 disables sampling
+    int getResourceSamplingInterval()
+    {
+        static int ResourceSamplingInterval = 5000;
+        JValueUtil::getValue(m_readOnlyDatabase, "ResourceSamplingInterval", ResourceSamplingInterval);
+        return ResourceSamplingInterval;
+    }
+
+    // "launch", "foreground" or "background"
+    JValue getSchedulingPolicy(const string& name) const
+    {
+        JValue SchedulingPolicy = pbnjson::Object();
+        JValueUtil::getValue(m_readOnlyDatabase, "SchedulingPolicy", name, SchedulingPolicy);
+        return SchedulingPolicy;
+    }
+
     const string& getRespawnedPath()
     {
         static string RespawnedPath = "/tmp/sam-respawned";
@@ -168,7 +250,7 @@ public:
             return;
 
         m_readWriteDatabase.put("keepAliveApps", array);
-        saveReadWriteConf();
+        markReadWriteConfDirty();
     }
 
     JValue getSysAssetFallbackPrecedence() const
@@ -188,7 +270,7 @@ public:
             return;
 
         m_readWriteDatabase.put("sysAssetFallbackPrecedence", array);
-        saveReadWriteConf();
+        markReadWriteConfDirty();
     }
 
     bool isDeletedSystemApp(const string& appId) const
@@ -218,7 +300,7 @@ public:
             m_readWriteDatabase.put("deletedSystemApps", pbnjson::Array());
         }
         m_readWriteDatabase["deletedSystemApps"].append(appId);
-        saveReadWriteConf();
+        markReadWriteConfDirty();
     }
 
     const string& getLanguage() const
@@ -249,7 +331,7 @@ public:
         m_readWriteDatabase.put("language", language);
         m_readWriteDatabase.put("script", script);
         m_readWriteDatabase.put("region", region);
-        saveReadWriteConf();
+        markReadWriteConfDirty();
     }
 
     bool isBlockedApp(const string& appId) const
@@ -296,13 +378,18 @@ public:
     }
 
 private:
+    static gboolean onFlushReadWriteConf(gpointer context);
+
     SAMConf();
 
     void loadReadOnlyConf();
     void loadReadWriteConf();
     void saveReadWriteConf();
+    void markReadWriteConfDirty();
     void loadBlockedList();
 
+    string getReadWriteConfPath();
+
     JValue m_readOnlyDatabase;
     JValue m_readWriteDatabase;
     JValue m_blockedListDatabase;
@@ -310,6 +397,10 @@ private:
     bool m_isRespawned;
     bool m_isDevmodeEnabled;
     bool m_isJailerDisabled;
+
+    bool m_isReadWriteConfDirty;
+    guint m_flushSourceId;
+    unsigned int m_flushCount;
 };
 
 #endif // __CONF_SAM_FONF_H__
@@ -0,0 +1,375 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "MemoryPolicy.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+#include <glib-unix.h>
+
+#include "base/RunningAppList.h"
+#include "bus/client/AbsLifeHandler.h"
+#include "bus/client/MemoryManager.h"
+#include "conf/SAMConf.h"
+#include "util/File.h"
+#include "util/Logger.h"
+#include "util/Time.h"
+
+static const char* PATH_PRESSURE_MEMORY = "/proc/pressure/memory";
+
+gboolean MemoryPolicy::onUpdate(gpointer context)
+{
+    MemoryPolicy::getInstance().m_updateSourceId = 0;
+    MemoryPolicy::getInstance().enforceBudget();
+    MemoryPolicy::getInstance().rankOOMScores();
+    return G_SOURCE_REMOVE;
+}
+
+gboolean MemoryPolicy::onPressure(gint fd, GIOCondition condition, gpointer context)
+{
+    if (condition & G_IO_ERR) {
+        Logger::error(getInstance().getClassName(), __FUNCTION__, "PSI trigger is not available anymore");
+        getInstance().m_pressureSourceId = 0;
+        getInstance().closePressureTrigger();
+        return G_SOURCE_REMOVE;
+    }
+
+    getInstance().m_pressureTime = Time::getCurrentTime();
+    // MemoryManager handles memory pressure by itself
+    if (MemoryManager::getInstance().isConnected())
+        return G_SOURCE_CONTINUE;
+
+    Logger::warning(getInstance().getClassName(), __FUNCTION__, "Memory pressure is detected");
+    getInstance().reclaim(nullptr);
+    return G_SOURCE_CONTINUE;
+}
+
+MemoryPolicy::MemoryPolicy()
+    : m_updateSourceId(0),
+      m_evictionCount(0),
+      m_warmLaunchCount(0),
+      m_coldLaunchCount(0),
+      m_pressureFd(-1),
+      m_pressureSourceId(0),
+      m_pressureTime(0)
+{
+    setClassName("MemoryPolicy");
+}
+
+MemoryPolicy::~MemoryPolicy()
+{
+}
+
+void MemoryPolicy::initialize()
+{
+    // Apps reloaded by NativeContainer don't have scores yet
+    update();
+
+    if (!openPressureTrigger())
+        Logger::info(getClassName(), __FUNCTION__, "PSI is not available. Memory pressure is only handled by MemoryManager");
+}
+
+void MemoryPolicy::finalize()
+{
+    if (m_updateSourceId != 0) {
+        g_source_remove(m_updateSourceId);
+        m_updateSourceId = 0;
+    }
+    closePressureTrigger();
+}
+
+bool MemoryPolicy::isUnderPressure()
+{
+    JValue conf = SAMConf::getInstance().getMemoryPressure();
+    int windowUs = 1000000;
+    int avg10 = 10;
+    JValueUtil::getValue(conf, "windowUs", windowUs);
+    JValueUtil::getValue(conf, "avg10", avg10);
+
+    // Trigger was fired within last window
+    if (m_pressureTime != 0 && Time::getCurrentTime() - m_pressureTime < windowUs / 1000)
+        return true;
+
+    // some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    string pressure = File::readFile(PATH_PRESSURE_MEMORY);
+    size_t pos = pressure.find("avg10=");
+    if (pos == string::npos)
+        return false;
+    return atof(pressure.c_str() + pos + 6) >= avg10;
+}
+
+void MemoryPolicy::reclaim(RunningAppPtr launchingApp)
+{
+    JValue conf = SAMConf::getInstance().getMemoryPressure();
+    int reclaimCount = 1;
+    JValueUtil::getValue(conf, "reclaimCount", reclaimCount);
+
+    vector<RunningAppPtr> victims;
+    const map<string, RunningAppPtr>& runningApps = RunningAppList::getInstance().getRunningApps();
+    for (auto it = runningApps.begin(); it != runningApps.end(); ++it) {
+        RunningAppPtr runningApp = it->second;
+        if (runningApp == launchingApp || runningApp->isKeepAlive())
+            continue;
+
+        switch (runningApp->getLifeStatus()) {
+        case LifeStatus::LifeStatus_PRELOADED:
+        case LifeStatus::LifeStatus_BACKGROUND:
+        case LifeStatus::LifeStatus_PAUSED:
+            victims.push_back(runningApp);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    sort(victims.begin(), victims.end(), [](const RunningAppPtr& a, const RunningAppPtr& b) {
+        return a->getLastForegroundTime() < b->getLastForegroundTime();
+    });
+    for (int i = 0; i < reclaimCount && i < (int)victims.size(); ++i)
+        evict(victims[i], "pressure");
+}
+
+void MemoryPolicy::enforceBudget()
+{
+    JValue budget = SAMConf::getInstance().getBackgroundBudget();
+    int maxCount = 0;
+    int maxMemory = 0;
+    JValueUtil::getValue(budget, "maxCount", maxCount);
+    JValueUtil::getValue(budget, "maxMemory", maxMemory);
+    if (maxCount <= 0 && maxMemory <= 0)
+        return;
+
+    // Apps in 'keepAliveApps' of sam-conf are not evicted. But they take the budget.
+    vector<RunningAppPtr> candidates;
+    int count = 0;
+    long long memory = 0;
+    const map<string, RunningAppPtr>& runningApps = RunningAppList::getInstance().getRunningApps();
+    for (auto it = runningApps.begin(); it != runningApps.end(); ++it) {
+        switch (it->second->getLifeStatus()) {
+        case LifeStatus::LifeStatus_PRELOADED:
+        case LifeStatus::LifeStatus_BACKGROUND:
+        case LifeStatus::LifeStatus_PAUSED:
+            count++;
+            memory += getFootprint(it->second);
+            if (!SAMConf::getInstance().isKeepAliveApp(it->second->getAppId()))
+                candidates.push_back(it->second);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Coldest app is evicted first
+    sort(candidates.begin(), candidates.end(), [](const RunningAppPtr& a, const RunningAppPtr& b) {
+        return a->getLastForegroundTime() < b->getLastForegroundTime();
+    });
+    long long memoryLimit = (long long)maxMemory * 1024 * 1024;
+    for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        if (maxCount > 0 && count > maxCount) {
+            evict(*it, "count");
+        } else if (maxMemory > 0 && memory > memoryLimit) {
+            evict(*it, "memory");
+        } else {
+            break;
+        }
+        count--;
+        memory -= getFootprint(*it);
+    }
+}
+
+void MemoryPolicy::evict(RunningAppPtr runningApp, const string& reason)
+{
+    Logger::info(getClassName(), __FUNCTION__, runningApp->getAppId(), "Evicted by " + reason);
+
+    JValue eviction = pbnjson::Object();
+    eviction.put("appId", runningApp->getAppId());
+    eviction.put("instanceId", runningApp->getInstanceId());
+    eviction.put("reason", reason);
+    eviction.put("footprint", (int64_t)getFootprint(runningApp));
+    eviction.put("idleTime", (int64_t)(Time::getCurrentTime() - runningApp->getLastForegroundTime()));
+    m_evictions.push_back(eviction);
+    if (m_evictions.size() > MAX_EVICTIONS)
+        m_evictions.pop_front();
+    m_evictionCount++;
+
+    runningApp->setReason(reason == "pressure" ? "memoryReclaim" : "keepAliveBudget");
+    AbsLifeHandler::getLifeHandler(runningApp).kill(runningApp);
+}
+
+long long MemoryPolicy::getFootprint(RunningAppPtr runningApp)
+{
+    // Sampled by ResourceMonitor. Otherwise, use estimated value.
+    if (runningApp->getResourceStat().sampledTime != 0)
+        return runningApp->getResourceStat().memoryCurrent;
+
+    int defaultFootprint = 100;
+    JValueUtil::getValue(SAMConf::getInstance().getBackgroundBudget(), "defaultFootprint", defaultFootprint);
+    return (long long)defaultFootprint * 1024 * 1024;
+}
+
+bool MemoryPolicy::openPressureTrigger()
+{
+    JValue conf = SAMConf::getInstance().getMemoryPressure();
+    int stallUs = 150000;
+    int windowUs = 1000000;
+    JValueUtil::getValue(conf, "stallUs", stallUs);
+    JValueUtil::getValue(conf, "windowUs", windowUs);
+    if (stallUs <= 0)
+        return false;
+
+    m_pressureFd = open(PATH_PRESSURE_MEMORY, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (m_pressureFd < 0)
+        return false;
+
+    // Notified once per window if tasks are stalled more than stallUs in total
+    string trigger = "some " + std::to_string(stallUs) + " " + std::to_string(windowUs);
+    if (write(m_pressureFd, trigger.c_str(), trigger.size() + 1) < 0) {
+        Logger::error(getClassName(), __FUNCTION__, trigger, strerror(errno));
+        closePressureTrigger();
+        return false;
+    }
+    m_pressureSourceId = g_unix_fd_add(m_pressureFd, (GIOCondition)(G_IO_PRI | G_IO_ERR), onPressure, nullptr);
+    return true;
+}
+
+void MemoryPolicy::closePressureTrigger()
+{
+    if (m_pressureSourceId != 0) {
+        g_source_remove(m_pressureSourceId);
+        m_pressureSourceId = 0;
+    }
+    if (m_pressureFd >= 0) {
+        close(m_pressureFd);
+        m_pressureFd = -1;
+    }
+}
+
+void MemoryPolicy::update()
+{
+    if (m_updateSourceId != 0)
+        return;
+    m_updateSourceId = g_idle_add(onUpdate, nullptr);
+}
+
+void MemoryPolicy::countLaunch(bool isWarm)
+{
+    if (isWarm)
+        m_warmLaunchCount++;
+    else
+        m_coldLaunchCount++;
+}
+
+void MemoryPolicy::toJson(JValue& json)
+{
+    JValue budget = SAMConf::getInstance().getBackgroundBudget();
+    int residentCount = 0;
+    long long residentMemory = 0;
+    const map<string, RunningAppPtr>& runningApps = RunningAppList::getInstance().getRunningApps();
+    for (auto it = runningApps.begin(); it != runningApps.end(); ++it) {
+        switch (it->second->getLifeStatus()) {
+        case LifeStatus::LifeStatus_PRELOADED:
+        case LifeStatus::LifeStatus_BACKGROUND:
+        case LifeStatus::LifeStatus_PAUSED:
+            residentCount++;
+            residentMemory += getFootprint(it->second);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    JValue evictions = pbnjson::Array();
+    for (auto it = m_evictions.begin(); it != m_evictions.end(); ++it)
+        evictions.append(*it);
+
+    json.put("budget", budget);
+    json.put("residentCount", residentCount);
+    json.put("residentMemory", (int64_t)residentMemory);
+    json.put("evictionCount", m_evictionCount);
+    json.put("evictions", evictions);
+    json.put("warmLaunchCount", m_warmLaunchCount);
+    json.put("coldLaunchCount", m_coldLaunchCount);
+}
+
+void MemoryPolicy::rankOOMScores()
+{
+    JValue conf = SAMConf::getInstance().getOOMScoreAdj();
+    int foreground = 0;
+    int keepAlive = 100;
+    int background = 300;
+    int backgroundStep = 50;
+    int backgroundMax = 900;
+    JValueUtil::getValue(conf, "foreground", foreground);
+    JValueUtil::getValue(conf, "keepAlive", keepAlive);
+    JValueUtil::getValue(conf, "background", background);
+    JValueUtil::getValue(conf, "backgroundStep", backgroundStep);
+    JValueUtil::getValue(conf, "backgroundMax", backgroundMax);
+
+    vector<RunningAppPtr> backgroundApps;
+    const map<string, RunningAppPtr>& runningApps = RunningAppList::getInstance().getRunningApps();
+    for (auto it = runningApps.begin(); it != runningApps.end(); ++it) {
+        RunningAppPtr runningApp = it->second;
+        // WAM owns processes of web apps
+        if (runningApp->getLaunchPoint()->getAppDesc()->getAppType() == AppType::AppType_Web)
+            continue;
+        if (runningApp->getProcessId() <= 0)
+            continue;
+
+        int score = 0;
+        switch (runningApp->getLifeStatus()) {
+        case LifeStatus::LifeStatus_SPLASHING:
+        case LifeStatus::LifeStatus_SPLASHED:
+        case LifeStatus::LifeStatus_LAUNCHING:
+        case LifeStatus::LifeStatus_RELAUNCHING:
+        case LifeStatus::LifeStatus_FOREGROUND:
+            score = foreground;
+            break;
+
+        default:
+            if (!runningApp->isKeepAlive()) {
+                backgroundApps.push_back(runningApp);
+                continue;
+            }
+            score = keepAlive;
+            break;
+        }
+
+        if (runningApp->getOOMScoreAdj() != score && runningApp->getLinuxProcess().setOOMScoreAdj(score))
+            runningApp->setOOMScoreAdj(score);
+    }
+
+    // Least recently used app is killed first
+    sort(backgroundApps.begin(), backgroundApps.end(), [](const RunningAppPtr& a, const RunningAppPtr& b) {
+        return a->getLastForegroundTime() > b->getLastForegroundTime();
+    });
+    for (size_t i = 0; i < backgroundApps.size(); ++i) {
+        int score = min(background + (int)i * backgroundStep, backgroundMax);
+        if (backgroundApps[i]->getOOMScoreAdj() == score)
+            continue;
+        if (backgroundApps[i]->getLinuxProcess().setOOMScoreAdj(score)) {
+            backgroundApps[i]->setOOMScoreAdj(score);
+            Logger::debug(getClassName(), __FUNCTION__, backgroundApps[i]->getAppId(), Logger::format("oom_score_adj: %d", score));
+        }
+    }
+}
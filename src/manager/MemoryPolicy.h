@@ -0,0 +1,89 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef MANAGER_MEMORYPOLICY_H_
+#define MANAGER_MEMORYPOLICY_H_
+
+#include <iostream>
+#include <deque>
+#include <glib.h>
+#include <pbnjson.hpp>
+
+#include "base/RunningApp.h"
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+using namespace pbnjson;
+
+// Decides which native apps the kernel should reclaim first
+class MemoryPolicy : public ISingleton<MemoryPolicy>,
+                     public IClassName {
+friend class ISingleton<MemoryPolicy> ;
+public:
+    static const int OOM_SCORE_ADJ_UNKNOWN = -1001;
+
+    virtual ~MemoryPolicy();
+
+    void initialize();
+    void finalize();
+
+    // oom_score_adj is ranked by life status, keepAlive and last foreground time.
+    // Background budget is checked at the same time.
+    // Both are done once in idle even though several apps are changed together.
+    void update();
+
+    void countLaunch(bool isWarm);
+    void toJson(JValue& json);
+
+    // Local fallback of MemoryManager.
+    // Background apps are closed in LRU order if memory is under pressure.
+    bool isUnderPressure();
+    void reclaim(RunningAppPtr launchingApp);
+
+private:
+    static const unsigned int MAX_EVICTIONS = 32;
+
+    static gboolean onUpdate(gpointer context);
+    static gboolean onPressure(gint fd, GIOCondition condition, gpointer context);
+
+    MemoryPolicy();
+
+    void rankOOMScores();
+    void enforceBudget();
+    void evict(RunningAppPtr runningApp, const string& reason);
+
+    long long getFootprint(RunningAppPtr runningApp);
+
+    bool openPressureTrigger();
+    void closePressureTrigger();
+
+    guint m_updateSourceId;
+
+    // Recent eviction records for managerInfo
+    deque<JValue> m_evictions;
+    int m_evictionCount;
+    int m_warmLaunchCount;
+    int m_coldLaunchCount;
+
+    // PSI trigger of /proc/pressure/memory
+    int m_pressureFd;
+    guint m_pressureSourceId;
+    long long m_pressureTime;
+};
+
+#endif /* MANAGER_MEMORYPOLICY_H_ */
@@ -20,6 +20,7 @@
 #include "bus/client/WAM.h"
 #include "bus/client/NativeContainer.h"
 #include "bus/client/MemoryManager.h"
+#include "manager/Prewarmer.h"
 
 PolicyManager::PolicyManager()
 {
@@ -49,6 +50,8 @@ void PolicyManager::launch(LunaTaskPtr lunaTask)
     }
     runningApp->setLifeStatus(LifeStatus::LifeStatus_SPLASHING);
     RunningAppList::getInstance().add(runningApp);
+    // Overlaps disk reads with memory check
+    Prewarmer::getInstance().prewarm(runningApp);
 
     lunaTask->setSuccessCallback(boost::bind(&PolicyManager::onRequireMemory, this, boost::placeholders::_1));
     MemoryManager::getInstance().requireMemory(runningApp, lunaTask);
@@ -116,6 +119,22 @@ void PolicyManager::relaunch(LunaTaskPtr lunaTask)
         return;
     }
 
+    // Paused native app is resumed instead of being restarted.
+    if (runningApp->getLinuxProcess().isFrozen()) {
+        if (!runningApp->getLinuxProcess().thaw()) {
+            lunaTask->setErrCodeAndText(ErrCode_LAUNCH, lunaTask->getId() + " cannot be thawed");
+            lunaTask->error(lunaTask);
+            return;
+        }
+        // 'launch' event makes LSM raise its window
+        if (!runningApp->isRegistered()) {
+            runningApp->setLifeStatus(LifeStatus::LifeStatus_LAUNCHING);
+            runningApp->startThawedTimer();
+            lunaTask->success(lunaTask);
+            return;
+        }
+    }
+
     if (runningApp->isRegistered()) {
         JValue payload = pbnjson::Object();
         runningApp->toEventJson(payload, lunaTask, "relaunch");
@@ -0,0 +1,179 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "Prewarmer.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+#include "conf/SAMConf.h"
+#include "util/JValueUtil.h"
+#include "util/Logger.h"
+
+// Pushed by finalize to stop the thread
+static vector<string> STOP_REQUEST;
+
+gpointer Prewarmer::onThread(gpointer context)
+{
+    GAsyncQueue* queue = (GAsyncQueue*) context;
+    while (true) {
+        vector<string>* paths = (vector<string>*) g_async_queue_pop(queue);
+        if (paths == &STOP_REQUEST)
+            break;
+
+        for (auto it = paths->begin(); it != paths->end(); ++it)
+            readahead(*it);
+        delete paths;
+    }
+    return nullptr;
+}
+
+void Prewarmer::readahead(const string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        // readahead(2) blocks until pages are read. fadvise is the fallback on filesystems without it.
+        if (::readahead(fd, 0, st.st_size) != 0)
+            posix_fadvise(fd, 0, st.st_size, POSIX_FADV_WILLNEED);
+    }
+    ::close(fd);
+}
+
+Prewarmer::Prewarmer()
+    : m_thread(nullptr),
+      m_queue(nullptr),
+      m_maxFiles(0)
+{
+    setClassName("Prewarmer");
+}
+
+Prewarmer::~Prewarmer()
+{
+}
+
+void Prewarmer::initialize()
+{
+    JValue prewarm = SAMConf::getInstance().getPrewarm();
+    m_maxFiles = 64;
+    JValueUtil::getValue(prewarm, "maxFiles", m_maxFiles);
+    if (m_maxFiles <= 0) {
+        Logger::info(getClassName(), __FUNCTION__, "Prewarm is disabled");
+        return;
+    }
+
+    m_queue = g_async_queue_new();
+    m_thread = g_thread_new("prewarm", onThread, m_queue);
+}
+
+void Prewarmer::finalize()
+{
+    if (m_thread == nullptr)
+        return;
+
+    g_async_queue_push(m_queue, &STOP_REQUEST);
+    g_thread_join(m_thread);
+    m_thread = nullptr;
+    g_async_queue_unref(m_queue);
+    m_queue = nullptr;
+}
+
+void Prewarmer::prewarm(RunningAppPtr runningApp)
+{
+    if (m_thread == nullptr)
+        return;
+
+    AppDescriptionPtr appDesc = runningApp->getLaunchPoint()->getAppDesc();
+    vector<string>* paths = new vector<string>();
+    addPath(*paths, appDesc->getAbsMain());
+    addPath(*paths, appDesc->getSplashBackground());
+
+    auto it = m_learnedFiles.find(appDesc->getAppId());
+    if (it != m_learnedFiles.end()) {
+        for (auto path = it->second.begin(); path != it->second.end(); ++path)
+            addPath(*paths, *path);
+    }
+
+    if (paths->empty()) {
+        delete paths;
+        return;
+    }
+    Logger::debug(getClassName(), __FUNCTION__, runningApp->getAppId(), Logger::format("files(%d)", (int) paths->size()));
+    g_async_queue_push(m_queue, paths);
+}
+
+void Prewarmer::learn(RunningApp& runningApp)
+{
+    if (m_thread == nullptr)
+        return;
+    // WAM and qml-runner do not map app files
+    AppDescriptionPtr appDesc = runningApp.getLaunchPoint()->getAppDesc();
+    if (appDesc->getAppType() == AppType::AppType_Web || appDesc->getAppType() == AppType::AppType_Native_Qml)
+        return;
+    // Shared libraries are already in page cache. Only files of the app are worth prewarming.
+    string folderPath = appDesc->getFolderPath();
+    if (folderPath.empty())
+        return;
+    if (folderPath.back() != '/')
+        folderPath += '/';
+    pid_t pid = runningApp.getLinuxProcess().getPid();
+    if (pid <= 0)
+        return;
+
+    ifstream maps("/proc/" + to_string(pid) + "/maps");
+    if (!maps.is_open())
+        return;
+
+    vector<string> files;
+    set<string> visited;
+    string line;
+    while (getline(maps, line) && (int) files.size() < m_maxFiles) {
+        size_t pos = line.find('/');
+        if (pos == string::npos)
+            continue;
+        string path = line.substr(pos);
+        if (path.compare(0, folderPath.size(), folderPath) != 0 || path.find(" (deleted)") != string::npos)
+            continue;
+        if (visited.insert(path).second)
+            files.push_back(path);
+    }
+    if (files.empty())
+        return;
+
+    Logger::debug(getClassName(), __FUNCTION__, runningApp.getAppId(), Logger::format("files(%d)", (int) files.size()));
+    m_learnedFiles[runningApp.getAppId()] = files;
+}
+
+void Prewarmer::addPath(vector<string>& paths, const string& path)
+{
+    string file = path;
+    if (file.compare(0, 7, "file://") == 0)
+        file.erase(0, 7);
+    if (file.empty() || file[0] != '/')
+        return;
+    if ((int) paths.size() >= m_maxFiles)
+        return;
+    if (find(paths.begin(), paths.end(), file) != paths.end())
+        return;
+    paths.push_back(file);
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef MANAGER_PREWARMER_H_
+#define MANAGER_PREWARMER_H_
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <glib.h>
+
+#include "base/RunningApp.h"
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+// Reads app files into page cache on a helper thread while launch is in progress.
+// Files mapped by native apps are learned when they get foreground.
+class Prewarmer : public ISingleton<Prewarmer>,
+                  public IClassName {
+friend class ISingleton<Prewarmer> ;
+public:
+    virtual ~Prewarmer();
+
+    void initialize();
+    void finalize();
+
+    void prewarm(RunningAppPtr runningApp);
+    void learn(RunningApp& runningApp);
+
+private:
+    static gpointer onThread(gpointer context);
+    static void readahead(const string& path);
+
+    Prewarmer();
+
+    void addPath(vector<string>& paths, const string& path);
+
+    GThread* m_thread;
+    GAsyncQueue* m_queue;
+    int m_maxFiles;
+
+    // appId => files mapped in previous launch
+    map<string, vector<string>> m_learnedFiles;
+};
+
+#endif /* MANAGER_PREWARMER_H_ */
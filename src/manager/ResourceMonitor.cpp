@@ -0,0 +1,93 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "ResourceMonitor.h"
+
+#include "base/RunningAppList.h"
+#include "bus/service/ApplicationManager.h"
+#include "conf/SAMConf.h"
+#include "manager/MemoryPolicy.h"
+#include "util/Cgroup.h"
+#include "util/Logger.h"
+
+gboolean ResourceMonitor::onSample(gpointer context)
+{
+    ResourceMonitor::getInstance().sample();
+    return G_SOURCE_CONTINUE;
+}
+
+ResourceMonitor::ResourceMonitor()
+    : m_sampleSourceId(0),
+      m_isControllerMissing(false)
+{
+    setClassName("ResourceMonitor");
+}
+
+ResourceMonitor::~ResourceMonitor()
+{
+}
+
+void ResourceMonitor::initialize()
+{
+    int interval = SAMConf::getInstance().getResourceSamplingInterval();
+    if (interval <= 0) {
+        Logger::info(getClassName(), __FUNCTION__, "Resource sampling is disabled");
+        return;
+    }
+
+    // Accounting files of child groups exist only when controllers are enabled in parent
+    string cgroupPath = SAMConf::getInstance().getNativeCgroupPath();
+    if (Cgroup::isAvailable(cgroupPath))
+        Cgroup::enableControllers(cgroupPath);
+    m_sampleSourceId = g_timeout_add(interval, onSample, nullptr);
+}
+
+void ResourceMonitor::finalize()
+{
+    if (m_sampleSourceId != 0) {
+        g_source_remove(m_sampleSourceId);
+        m_sampleSourceId = 0;
+    }
+}
+
+void ResourceMonitor::sample()
+{
+    bool isSampled = false;
+    const map<string, RunningAppPtr>& runningApps = RunningAppList::getInstance().getRunningApps();
+    for (auto it = runningApps.begin(); it != runningApps.end(); ++it) {
+        const string& cgroup = it->second->getLinuxProcess().getCgroup();
+        if (cgroup.empty())
+            continue;
+
+        CgroupStat stat;
+        if (!Cgroup::readStat(cgroup, stat)) {
+            if (!m_isControllerMissing) {
+                Logger::warning(getClassName(), __FUNCTION__, it->second->getAppId(), "Failed to read cgroup stat. memory controller may be missing");
+                m_isControllerMissing = true;
+            }
+            continue;
+        }
+        it->second->setResourceStat(stat);
+        isSampled = true;
+    }
+
+    // Budget depends on sampled footprint
+    if (isSampled)
+        MemoryPolicy::getInstance().update();
+    // Apps without cgroup are also listed to subscribers
+    ApplicationManager::getInstance().postRunningResources();
+}
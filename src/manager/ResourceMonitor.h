@@ -0,0 +1,52 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef MANAGER_RESOURCEMONITOR_H_
+#define MANAGER_RESOURCEMONITOR_H_
+
+#include <iostream>
+#include <glib.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+// Samples cgroup accounting of native apps in one place.
+// Clients read the latest sample through 'running' and 'managerInfo' instead of scanning /proc.
+class ResourceMonitor : public ISingleton<ResourceMonitor>,
+                        public IClassName {
+friend class ISingleton<ResourceMonitor> ;
+public:
+    virtual ~ResourceMonitor();
+
+    void initialize();
+    void finalize();
+
+    void sample();
+
+private:
+    static gboolean onSample(gpointer context);
+
+    ResourceMonitor();
+
+    guint m_sampleSourceId;
+    // Missing memory controller is reported once instead of every sample
+    bool m_isControllerMissing;
+};
+
+#endif /* MANAGER_RESOURCEMONITOR_H_ */
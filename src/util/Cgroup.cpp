@@ -0,0 +1,180 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Cgroup.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sstream>
+#include <sys/stat.h>
+
+#include "util/File.h"
+#include "util/Time.h"
+
+bool Cgroup::isAvailable(const string& path)
+{
+    if (path.empty())
+        return false;
+    if (!File::isDirectory(path) && mkdir(path.c_str(), 0755) != 0)
+        return false;
+
+    // 'cgroup.freeze' only exists in non-root cgroup-v2 groups
+    return File::isFile(File::join(path, "cgroup.freeze"));
+}
+
+bool Cgroup::hasProcess(const string& path, pid_t pid)
+{
+    string procs;
+    if (!readValue(path, "cgroup.procs", procs))
+        return false;
+
+    stringstream pids(procs);
+    pid_t member;
+    while (pids >> member) {
+        if (member == pid)
+            return true;
+    }
+    return false;
+}
+
+bool Cgroup::create(const string& path)
+{
+    if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST)
+        return false;
+    return true;
+}
+
+bool Cgroup::remove(const string& path)
+{
+    // Only empty group can be removed
+    if (rmdir(path.c_str()) != 0 && errno != ENOENT)
+        return false;
+    return true;
+}
+
+void Cgroup::enableControllers(const string& path)
+{
+    // Each controller is written separately. One unsupported controller fails the whole write.
+    writeValue(path, "cgroup.subtree_control", "+memory");
+    writeValue(path, "cgroup.subtree_control", "+cpu");
+    writeValue(path, "cgroup.subtree_control", "+io");
+}
+
+bool Cgroup::freeze(const string& path)
+{
+    return writeValue(path, "cgroup.freeze", "1");
+}
+
+bool Cgroup::thaw(const string& path)
+{
+    return writeValue(path, "cgroup.freeze", "0");
+}
+
+bool Cgroup::readStat(const string& path, CgroupStat& stat)
+{
+    string value;
+    if (!readValue(path, "memory.current", value))
+        return false;
+    stat.sampledTime = Time::getCurrentTime();
+    stat.memoryCurrent = atoll(value.c_str());
+
+    // 'memory.peak' is supported since linux 5.19
+    if (readValue(path, "memory.peak", value))
+        stat.memoryPeak = atoll(value.c_str());
+
+    // usage_usec 1234
+    // user_usec 1000
+    // system_usec 234
+    if (readValue(path, "cpu.stat", value)) {
+        stringstream lines(value);
+        string key;
+        long long number;
+        while (lines >> key >> number) {
+            if (key == "usage_usec")
+                stat.cpuUsageUsec = number;
+            else if (key == "user_usec")
+                stat.cpuUserUsec = number;
+            else if (key == "system_usec")
+                stat.cpuSystemUsec = number;
+        }
+    }
+
+    // 8:0 rbytes=1459200 wbytes=314773504 rios=192 wios=353 dbytes=0 dios=0
+    if (readValue(path, "io.stat", value)) {
+        stringstream fields(value);
+        string field;
+        while (fields >> field) {
+            size_t pos = field.find('=');
+            if (pos == string::npos)
+                continue;
+            string key = field.substr(0, pos);
+            long long number = atoll(field.c_str() + pos + 1);
+            if (key == "rbytes")
+                stat.ioReadBytes += number;
+            else if (key == "wbytes")
+                stat.ioWriteBytes += number;
+            else if (key == "rios")
+                stat.ioReadCount += number;
+            else if (key == "wios")
+                stat.ioWriteCount += number;
+        }
+    }
+    return true;
+}
+
+bool Cgroup::readValue(const string& path, const string& name, string& value)
+{
+    string file = File::join(path, name);
+    int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    // Files like 'cgroup.procs' can be longer than one read
+    char buffer[4096];
+    ssize_t size = 0;
+    value.clear();
+    while ((size = read(fd, buffer, sizeof(buffer))) > 0)
+        value.append(buffer, size);
+    close(fd);
+    if (size < 0)
+        return false;
+
+    while (!value.empty() && value.back() == '\n')
+        value.pop_back();
+    return true;
+}
+
+bool Cgroup::writeValue(const string& path, const string& name, const string& value)
+{
+    string file = File::join(path, name);
+    int fd = open(file.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    ssize_t size = write(fd, value.c_str(), value.size());
+    close(fd);
+    return (size == (ssize_t)value.size());
+}
+
+Cgroup::Cgroup()
+{
+}
+
+Cgroup::~Cgroup()
+{
+}
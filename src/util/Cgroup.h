@@ -0,0 +1,80 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UTIL_CGROUP_H_
+#define UTIL_CGROUP_H_
+
+#include <iostream>
+#include <sys/types.h>
+
+using namespace std;
+
+// Snapshot of accounting files of one group
+struct CgroupStat {
+    CgroupStat()
+        : sampledTime(0),
+          memoryCurrent(0),
+          memoryPeak(0),
+          cpuUsageUsec(0),
+          cpuUserUsec(0),
+          cpuSystemUsec(0),
+          ioReadBytes(0),
+          ioWriteBytes(0),
+          ioReadCount(0),
+          ioWriteCount(0)
+    {
+    }
+
+    long long sampledTime;
+    long long memoryCurrent;
+    long long memoryPeak;
+    long long cpuUsageUsec;
+    long long cpuUserUsec;
+    long long cpuSystemUsec;
+    long long ioReadBytes;
+    long long ioWriteBytes;
+    long long ioReadCount;
+    long long ioWriteCount;
+};
+
+// Helpers for cgroup-v2 unified hierarchy
+class Cgroup {
+public:
+    // The directory should be a cgroup-v2 group which SAM can create children in
+    static bool isAvailable(const string& path);
+
+    static bool hasProcess(const string& path, pid_t pid);
+
+    static bool create(const string& path);
+    static bool remove(const string& path);
+
+    // Makes controllers available in child groups. Missing controllers are skipped.
+    static void enableControllers(const string& path);
+
+    static bool freeze(const string& path);
+    static bool thaw(const string& path);
+
+    // memory.current, memory.peak, cpu.stat and io.stat
+    static bool readStat(const string& path, CgroupStat& stat);
+
+    static bool readValue(const string& path, const string& name, string& value);
+    static bool writeValue(const string& path, const string& name, const string& value);
+
+    Cgroup();
+    virtual ~Cgroup();
+};
+
+#endif /* UTIL_CGROUP_H_ */
@@ -0,0 +1,166 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "DirectoryCache.h"
+
+#include <dirent.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "util/Logger.h"
+
+DirectoryCache::DirectoryCache()
+    : m_pass(0)
+{
+    setClassName("DirectoryCache");
+}
+
+DirectoryCache::~DirectoryCache()
+{
+}
+
+void DirectoryCache::revalidate()
+{
+    m_pass++;
+}
+
+void DirectoryCache::remove(const string& path)
+{
+    if (path.empty())
+        return;
+
+    auto it = m_listings.lower_bound(path);
+    while (it != m_listings.end() && it->first.compare(0, path.length(), path) == 0) {
+        if (it->first.length() == path.length() || it->first[path.length()] == '/')
+            it = m_listings.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool DirectoryCache::isFile(const string& path)
+{
+    bool isDirectory = false;
+    return getEntry(path, isDirectory) && !isDirectory;
+}
+
+bool DirectoryCache::isDirectory(const string& path)
+{
+    bool isDirectory = false;
+    return getEntry(path, isDirectory) && isDirectory;
+}
+
+bool DirectoryCache::exists(const string& path)
+{
+    bool isDirectory = false;
+    return getEntry(path, isDirectory);
+}
+
+bool DirectoryCache::getDirectories(const string& path, vector<string>& directories)
+{
+    const Listing& listing = getListing(path);
+    if (!listing.isExist)
+        return false;
+
+    for (auto it = listing.entries.begin(); it != listing.entries.end(); ++it) {
+        if (it->second)
+            directories.push_back(it->first);
+    }
+    return true;
+}
+
+const DirectoryCache::Listing& DirectoryCache::getListing(const string& path)
+{
+    auto it = m_listings.find(path);
+    if (it != m_listings.end() && it->second.pass == m_pass)
+        return it->second;
+
+    struct stat st;
+    bool isExist = (stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode));
+
+    if (it == m_listings.end()) {
+        it = m_listings.insert(make_pair(path, Listing())).first;
+        it->second.isExist = false;
+    } else if (isExist == it->second.isExist &&
+               (!isExist || (st.st_mtim.tv_sec == it->second.mtime.tv_sec &&
+                             st.st_mtim.tv_nsec == it->second.mtime.tv_nsec))) {
+        it->second.pass = m_pass;
+        return it->second;
+    }
+
+    Listing& listing = it->second;
+    listing.pass = m_pass;
+    listing.isExist = isExist;
+    listing.entries.clear();
+    // Missing directory is cached as well until next pass
+    if (isExist) {
+        listing.mtime = st.st_mtim;
+        readListing(path, listing);
+    }
+    return listing;
+}
+
+void DirectoryCache::readListing(const string& path, Listing& listing)
+{
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        Logger::warning(getClassName(), __FUNCTION__, path, "Failed to open directory");
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+
+        bool isDirectory = (entry->d_type == DT_DIR);
+        // Type of symbolic link is decided by its target like access() does
+        if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) {
+            struct stat st;
+            string child = path + "/" + entry->d_name;
+            if (stat(child.c_str(), &st) != 0)
+                continue;
+            isDirectory = S_ISDIR(st.st_mode);
+        }
+        listing.entries[entry->d_name] = isDirectory;
+    }
+    closedir(dir);
+}
+
+bool DirectoryCache::getEntry(const string& path, bool& isDirectory)
+{
+    string normalized;
+    for (char c : path) {
+        if (c == '/' && !normalized.empty() && normalized.back() == '/')
+            continue;
+        normalized += c;
+    }
+    while (normalized.length() > 1 && normalized.back() == '/')
+        normalized.pop_back();
+
+    size_t pos = normalized.find_last_of('/');
+    if (pos == string::npos || pos + 1 == normalized.length())
+        return false;
+
+    string parent = (pos == 0) ? "/" : normalized.substr(0, pos);
+    const Listing& listing = getListing(parent);
+    auto it = listing.entries.find(normalized.substr(pos + 1));
+    if (it == listing.entries.end())
+        return false;
+
+    isDirectory = it->second;
+    return true;
+}
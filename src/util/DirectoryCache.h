@@ -0,0 +1,71 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UTIL_DIRECTORYCACHE_H_
+#define UTIL_DIRECTORYCACHE_H_
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <time.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+// Answers existence checks from cached directory listings instead of access() or stat().
+// A listing is read by one readdir pass and reused until mtime of the directory is changed.
+// Mtime is checked only once per pass which is started by revalidate().
+class DirectoryCache : public ISingleton<DirectoryCache>,
+                       public IClassName {
+friend class ISingleton<DirectoryCache> ;
+public:
+    virtual ~DirectoryCache();
+
+    // Starts new pass. Each directory is stat-ed again on its first lookup.
+    void revalidate();
+    // Drops listings of the path and all directories under it
+    void remove(const string& path);
+
+    bool isFile(const string& path);
+    bool isDirectory(const string& path);
+    bool exists(const string& path);
+
+    // Subdirectory names of path. Returns false if path is not a directory.
+    bool getDirectories(const string& path, vector<string>& directories);
+
+private:
+    struct Listing {
+        bool isExist;
+        struct timespec mtime;
+        int pass;
+        // name => isDirectory
+        map<string, bool> entries;
+    };
+
+    DirectoryCache();
+
+    const Listing& getListing(const string& path);
+    void readListing(const string& path, Listing& listing);
+    // Returns false if the entry doesn't exist
+    bool getEntry(const string& path, bool& isDirectory);
+
+    map<string, Listing> m_listings;
+    int m_pass;
+};
+
+#endif /* UTIL_DIRECTORYCACHE_H_ */
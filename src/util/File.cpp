@@ -16,6 +16,9 @@
 
 #include "File.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -31,15 +34,19 @@ void File::set_slash_to_base_path(string& path)
 
 string File::readFile(const string& file_name)
 {
-    ifstream file(file_name.c_str(), ifstream::in);
+    // read() instead of mmap. Other processes may rewrite the file while it is read.
     string file_contents;
-
-    if (file.is_open() && file.good()) {
-        stringstream buf;
-        buf << file.rdbuf();
-        file_contents = buf.str();
+    int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return file_contents;
+
+    char buffer[4096];
+    ssize_t length;
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0 || (length < 0 && errno == EINTR)) {
+        if (length > 0)
+            file_contents.append(buffer, length);
     }
-
+    close(fd);
     return file_contents;
 }
 
@@ -55,6 +62,41 @@ bool File::writeFile(const string &path, const string& buffer)
     return true;
 }
 
+bool File::writeFileAtomically(const string& path, const string& buffer)
+{
+    // Readers should see either the old file or the new one, never a truncated one
+    string tmpPath = path + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return false;
+
+    const char* data = buffer.c_str();
+    size_t remain = buffer.size();
+    while (remain > 0) {
+        ssize_t written = write(fd, data, remain);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            close(fd);
+            unlink(tmpPath.c_str());
+            return false;
+        }
+        data += written;
+        remain -= written;
+    }
+
+    bool isSynced = (fsync(fd) == 0);
+    if (close(fd) != 0 || !isSynced) {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
 bool File::concatToFilename(const string originPath, string& returnPath, const string addingStr)
 {
     if (originPath.empty() || addingStr.empty())
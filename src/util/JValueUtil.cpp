@@ -12,6 +12,8 @@
  */
 
 #include "util/JValueUtil.h"
+#include "util/File.h"
+#include "util/MappedFile.h"
 #include "Environment.h"
 
 map<string, JSchema> JValueUtil::s_schemas;
@@ -29,6 +31,35 @@ void JValueUtil::addUniqueItemToArray(pbnjson::JValue& array, string& item)
     array.append(item);
 }
 
+void JValueUtil::putRaw(string& object, const string& key, const string& rawValue)
+{
+    size_t end = object.rfind('}');
+    if (end == string::npos)
+        return;
+
+    size_t last = object.find_last_not_of(" \t\n", end - 1);
+    bool isEmpty = (last == string::npos || object[last] == '{');
+    string member = (isEmpty ? "" : ",") + JValue(key).stringify() + ":" + rawValue;
+    object.insert(end, member);
+}
+
+JValue JValueUtil::parseFile(const string& path, const JSchema& schema)
+{
+    string content = File::readFile(path);
+    if (content.empty())
+        return JValue();
+    return JDomParser::fromString(JInput(content), schema);
+}
+
+JValue JValueUtil::parseMappedFile(const string& path, const JSchema& schema)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return JValue();
+    // Mapped pages are parsed in place without copying them into string
+    return JDomParser::fromString(JInput(file.getData(), file.getSize()), schema);
+}
+
 JSchema JValueUtil::getSchema(string name)
 {
     if (name.empty())
@@ -29,6 +29,15 @@ public:
     static void addUniqueItemToArray(JValue& arr, string& str);
     static JSchema getSchema(string name);
 
+    // Returns null JValue if the file cannot be read or parsed like JDomParser::fromFile.
+    static JValue parseFile(const string& path, const JSchema& schema = JSchema::AllSchema());
+    // Parses mapped file in place. Only for files which are never written in place (appinfo in app dirs).
+    // Truncating a mapped file raises SIGBUS in reader.
+    static JValue parseMappedFile(const string& path, const JSchema& schema = JSchema::AllSchema());
+
+    // Adds already serialized value to serialized object without parsing it again
+    static void putRaw(string& object, const string& key, const string& rawValue);
+
     template <typename T>
     static bool getValue(const JValue& json, const string& key, T& value) {
         if (!json)
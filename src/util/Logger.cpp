@@ -61,6 +61,14 @@ void Logger::logCallRequest(const string& className, const string& functionName,
         getInstance().write(LogLevel_INFO, className, functionName, "CallRequest", method.c_str(), EMPTY);
 }
 
+void Logger::logCallRequest(const string& className, const string& functionName, const string& method, const string& requestPayload)
+{
+    if (isVerbose())
+        getInstance().write(LogLevel_INFO, className, functionName, "CallRequest", method.c_str(), requestPayload);
+    else
+        getInstance().write(LogLevel_INFO, className, functionName, "CallRequest", method.c_str(), EMPTY);
+}
+
 void Logger::logCallResponse(const string& className, const string& functionName, Message& response, JValue& responsePayload)
 {
     if (isVerbose())
@@ -93,6 +101,14 @@ void Logger::logSubscriptionPost(const string& className, const string& function
         getInstance().write(LogLevel_INFO, className, functionName, "SubscriptionPost", Logger::format("Count=%d", point.getSubscribersCount()), EMPTY);
 }
 
+void Logger::logSubscriptionPost(const string& className, const string& functionName, const LS::SubscriptionPoint& point, const string& subscriptionPayload)
+{
+    if (isVerbose())
+        getInstance().write(LogLevel_INFO, className, functionName, "SubscriptionPost", Logger::format("Count=%d", point.getSubscribersCount()), subscriptionPayload);
+    else
+        getInstance().write(LogLevel_INFO, className, functionName, "SubscriptionPost", Logger::format("Count=%d", point.getSubscribersCount()), EMPTY);
+}
+
 void Logger::logSubscriptionPost(const string& className, const string& functionName, const string& key, JValue& subscriptionPayload)
 {
     if (isVerbose())
@@ -82,11 +82,14 @@ public:
     static void logAPIResponse(const string& className, const string& functionName, Message& request, JValue& responsePayload);
 
     static void logCallRequest(const string& className, const string& functionName, const string& method, JValue& requestPayload);
+    // Payload which is already serialized. It is written without indentation.
+    static void logCallRequest(const string& className, const string& functionName, const string& method, const string& requestPayload);
     static void logCallResponse(const string& className, const string& functionName, Message& response, JValue& responsePayload);
 
     static void logSubscriptionRequest(const string& className, const string& functionName, const string& method, JValue& requestPayload);
     static void logSubscriptionResponse(const string& className, const string& functionName, Message& response, JValue& subscriptionPayload);
     static void logSubscriptionPost(const string& className, const string& functionName, const LS::SubscriptionPoint& point, JValue& subscriptionPayload);
+    static void logSubscriptionPost(const string& className, const string& functionName, const LS::SubscriptionPoint& point, const string& subscriptionPayload);
     static void logSubscriptionPost(const string& className, const string& functionName, const string& key, JValue& subscriptionPayload);
 
     static void debug(const string& className, const string& functionName, const string& what);
@@ -0,0 +1,56 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UTIL_MAPPEDFILE_H_
+#define UTIL_MAPPEDFILE_H_
+
+#include <iostream>
+
+using namespace std;
+
+// Read-only memory mapping of whole file. It is unmapped when the object is destroyed.
+class MappedFile {
+public:
+    MappedFile();
+    virtual ~MappedFile();
+
+    bool open(const string& path);
+    void close();
+
+    bool isOpened() const
+    {
+        return m_data != nullptr;
+    }
+
+    const char* getData() const
+    {
+        return m_data;
+    }
+
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    char* m_data;
+    size_t m_size;
+};
+
+#endif /* UTIL_MAPPEDFILE_H_ */
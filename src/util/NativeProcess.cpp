@@ -15,9 +15,14 @@
 #include <errno.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sstream>
 
+#include "util/Cgroup.h"
 #include "util/NativeProcess.h"
 #include "util/Logger.h"
+#include "util/ProcessTracker.h"
 
 const string NativeProcess::CLASS_NAME = "NativeProcess";
 
@@ -36,6 +41,38 @@ void NativeProcess::prepareSpawn(gpointer user_data)
     if (result == -1) {
         Logger::error(CLASS_NAME, __FUNCTION__, strerror(errno));
     }
+
+    // Writing '0' moves the writer itself. All descendants are created in the cgroup.
+    // Only open/write/close are allowed here. Parent checks the result after spawn.
+    NativeProcess* self = static_cast<NativeProcess*>(user_data);
+    if (self != nullptr && !self->m_cgroupProcs.empty()) {
+        int fd = open(self->m_cgroupProcs.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            ssize_t size = write(fd, "0", 1);
+            (void) size;
+            close(fd);
+        }
+    }
+
+    // dup clears CLOEXEC. Pipe keeps a reader even after SAM exits.
+    if (self != nullptr && self->m_readerFd >= 0) {
+        int fd = dup(self->m_readerFd);
+        (void) fd;
+    }
+}
+
+bool NativeProcess::writeProcValue(const string& pid, const string& name, const string& value)
+{
+    string path = "/proc/" + pid + "/" + name;
+    int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    ssize_t size = write(fd, value.c_str(), value.size());
+    int error = errno;
+    close(fd);
+    errno = error;
+    return (size == (ssize_t)value.size());
 }
 
 NativeProcess::NativeProcess()
@@ -43,7 +80,10 @@ NativeProcess::NativeProcess()
       m_command(""),
       m_pid(-1),
       m_stdFd(-1),
-      m_isTracked(false)
+      m_readerFd(-1),
+      m_cgroup(""),
+      m_isTracked(false),
+      m_isFrozen(false)
 {
 
 }
@@ -76,17 +116,12 @@ void NativeProcess::addEnv(const string& variable, const string& value)
     m_environments[variable] = value;
 }
 
-void NativeProcess::openStdFile(const string& stdFile)
-{
-    closeStdFd();
-    m_stdFile = stdFile;
-    m_stdFd = ::open(stdFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
-}
-
 void NativeProcess::closeStdFd()
 {
     if (m_stdFd >= 0)
         close(m_stdFd);
+    m_stdFd = -1;
+    m_readerFd = -1;
 }
 
 bool NativeProcess::run()
@@ -111,6 +146,8 @@ bool NativeProcess::run()
         envp[index++] = (const char*)it->c_str();
     }
 
+    m_cgroupProcs = m_cgroup.empty() ? "" : File::join(m_cgroup, "cgroup.procs");
+
     Logger::info(CLASS_NAME, __FUNCTION__, m_command, params);
     gboolean result = g_spawn_async_with_fds(
         m_workingDirectory.c_str(),
@@ -125,6 +162,8 @@ bool NativeProcess::run()
         m_stdFd,
         &gerr
     );
+    // Parent doesn't need it. Otherwise reader never gets EOF.
+    closeStdFd();
     if (gerr) {
         Logger::error(CLASS_NAME, __FUNCTION__, gerr->message);
         g_error_free(gerr);
@@ -135,6 +174,13 @@ bool NativeProcess::run()
         Logger::error(CLASS_NAME, __FUNCTION__, "Failed to folk child process");
         return false;
     }
+
+    // g_spawn returns after exec. Freezing a group without the child would pause nothing.
+    if (!m_cgroup.empty() && !Cgroup::hasProcess(m_cgroup, m_pid)) {
+        Logger::warning(CLASS_NAME, __FUNCTION__, m_cgroup, "Child is not in cgroup");
+        Cgroup::remove(m_cgroup);
+        m_cgroup = "";
+    }
     return true;
 }
 
@@ -144,8 +190,7 @@ bool NativeProcess::term()
         Logger::error(CLASS_NAME, __FUNCTION__, "Process is not running");
         return false;
     }
-    int result = killpg(m_pid, SIGTERM);
-    if (result == -1) {
+    if (!sendSignal(SIGTERM)) {
         Logger::error(CLASS_NAME, __FUNCTION__, strerror(errno));
         return false;
     }
@@ -158,10 +203,92 @@ bool NativeProcess::kill()
         Logger::error(CLASS_NAME, __FUNCTION__, "Process is not running");
         return false;
     }
-    int result = killpg(m_pid, SIGKILL);
-    if (result == -1) {
+    if (!sendSignal(SIGKILL)) {
+        Logger::error(CLASS_NAME, __FUNCTION__, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool NativeProcess::sendSignal(int signal)
+{
+    // ProcessTracker knows whether pid is still owned by this process
+    if (ProcessTracker::getInstance().isWatched(m_pid))
+        return ProcessTracker::getInstance().sendSignal(m_pid, signal);
+    return (killpg(m_pid, signal) == 0);
+}
+
+bool NativeProcess::setNice(int nice)
+{
+    if (m_pid <= 0)
+        return false;
+    if (setpriority(PRIO_PGRP, m_pid, nice) == -1) {
         Logger::error(CLASS_NAME, __FUNCTION__, strerror(errno));
         return false;
     }
     return true;
 }
+
+bool NativeProcess::setIOPriority(int level)
+{
+    // glibc doesn't provide ioprio_set wrapper
+    static const int IOPRIO_WHO_PGRP = 2;
+    static const int IOPRIO_CLASS_BE = 2;
+    static const int IOPRIO_CLASS_SHIFT = 13;
+
+    if (m_pid <= 0)
+        return false;
+    if (syscall(SYS_ioprio_set, IOPRIO_WHO_PGRP, m_pid, (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | level) == -1) {
+        Logger::error(CLASS_NAME, __FUNCTION__, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool NativeProcess::setOOMScoreAdj(int oomScoreAdj)
+{
+    if (m_pid <= 0)
+        return false;
+
+    string procs = std::to_string(m_pid);
+    if (!m_cgroup.empty())
+        Cgroup::readValue(m_cgroup, "cgroup.procs", procs);
+
+    bool result = true;
+    stringstream pids(procs);
+    string pid;
+    while (pids >> pid) {
+        // Processes can exit at any time
+        if (!writeProcValue(pid, "oom_score_adj", std::to_string(oomScoreAdj)) && errno != ENOENT && errno != ESRCH) {
+            Logger::error(CLASS_NAME, __FUNCTION__, pid, strerror(errno));
+            result = false;
+        }
+    }
+    return result;
+}
+
+bool NativeProcess::freeze()
+{
+    if (m_cgroup.empty()) {
+        Logger::error(CLASS_NAME, __FUNCTION__, "Process is not in cgroup");
+        return false;
+    }
+    if (!Cgroup::freeze(m_cgroup)) {
+        Logger::error(CLASS_NAME, __FUNCTION__, m_cgroup, strerror(errno));
+        return false;
+    }
+    m_isFrozen = true;
+    return true;
+}
+
+bool NativeProcess::thaw()
+{
+    if (!m_isFrozen)
+        return true;
+    if (!Cgroup::thaw(m_cgroup)) {
+        Logger::error(CLASS_NAME, __FUNCTION__, m_cgroup, strerror(errno));
+        return false;
+    }
+    m_isFrozen = false;
+    return true;
+}
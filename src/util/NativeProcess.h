@@ -56,18 +56,46 @@ public:
         m_pid = pid;
     }
 
-    void openStdFile(const string& stdFile);
-    const string& getStdFile()
+    // stdout and stderr of child. It is closed in parent after spawn.
+    // readerFd is not owned. Child keeps a copy of it to avoid SIGPIPE without SAM.
+    void setStdFd(int stdFd, int readerFd = -1)
     {
-        return m_stdFile;
+        closeStdFd();
+        m_stdFd = stdFd;
+        m_readerFd = readerFd;
     }
 
     void closeStdFd();
 
+    // Child process is moved to the cgroup before exec
+    void setCgroup(const string& cgroup)
+    {
+        m_cgroup = cgroup;
+    }
+    const string& getCgroup() const
+    {
+        return m_cgroup;
+    }
+
     bool run();
     bool term();
     bool kill();
 
+    bool freeze();
+    bool thaw();
+
+    // Applied to whole process group
+    bool setNice(int nice);
+    bool setIOPriority(int level);
+
+    // All processes in cgroup or main process only
+    bool setOOMScoreAdj(int oomScoreAdj);
+
+    bool isFrozen() const
+    {
+        return m_isFrozen;
+    }
+
     void track()
     {
         m_isTracked = true;
@@ -90,6 +118,9 @@ private:
 
     static void convertEnvToStr(map<string, string>& src, vector<string>& dest);
     static void prepareSpawn(gpointer user_data);
+    static bool writeProcValue(const string& pid, const string& name, const string& value);
+
+    bool sendSignal(int signal);
 
     string m_workingDirectory;
     string m_command;
@@ -98,10 +129,14 @@ private:
     map<string, string> m_environments;
 
     pid_t m_pid;
-    string m_stdFile;
     gint m_stdFd;
+    gint m_readerFd;
+    string m_cgroup;
+    // Computed before fork. Child can use only async-signal-safe calls.
+    string m_cgroupProcs;
 
     bool m_isTracked;
+    bool m_isFrozen;
 
 };
 
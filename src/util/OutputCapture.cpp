@@ -0,0 +1,215 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "OutputCapture.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <glib-unix.h>
+
+#include "conf/RuntimeInfo.h"
+#include "conf/SAMConf.h"
+#include "util/File.h"
+#include "util/Logger.h"
+#include "util/Time.h"
+
+gboolean OutputCapture::onRead(gint fd, GIOCondition condition, gpointer context)
+{
+    auto pipe = getInstance().m_pipes.find(fd);
+    if (pipe == getInstance().m_pipes.end())
+        return G_SOURCE_REMOVE;
+    auto output = getInstance().m_outputs.find(pipe->second.appId);
+    if (output == getInstance().m_outputs.end())
+        return G_SOURCE_REMOVE;
+
+    if (getInstance().drain(fd, output->second))
+        return G_SOURCE_CONTINUE;
+
+    // Source is removed by returning G_SOURCE_REMOVE
+    getInstance().m_pipes[fd].sourceId = 0;
+    getInstance().closePipe(fd);
+    output->second.pipes--;
+    return G_SOURCE_REMOVE;
+}
+
+OutputCapture::OutputCapture()
+{
+    setClassName("OutputCapture");
+}
+
+OutputCapture::~OutputCapture()
+{
+}
+
+void OutputCapture::finalize()
+{
+    while (!m_pipes.empty())
+        closePipe(m_pipes.begin()->first);
+    m_outputs.clear();
+}
+
+int OutputCapture::open(const string& appId, int& readerFd)
+{
+    int fds[2];
+    readerFd = -1;
+    if (pipe2(fds, O_CLOEXEC | O_NONBLOCK) != 0) {
+        Logger::error(getClassName(), __FUNCTION__, appId, strerror(errno));
+        return -1;
+    }
+    // Child gets write end through dup2. CLOEXEC is cleared by dup2 but O_NONBLOCK is kept.
+    // A full pipe returns EAGAIN to the child instead of blocking it.
+
+    auto it = m_outputs.find(appId);
+    if (it == m_outputs.end()) {
+        int maxApps = 32;
+        int bufferSize = 64 * 1024;
+        JValueUtil::getValue(SAMConf::getInstance().getNativeOutput(), "maxApps", maxApps);
+        JValueUtil::getValue(SAMConf::getInstance().getNativeOutput(), "bufferSize", bufferSize);
+        if ((int)m_outputs.size() >= maxApps)
+            removeOldest();
+
+        Output output;
+        output.buffer.resize(bufferSize > 0 ? bufferSize : 1);
+        output.head = 0;
+        output.size = 0;
+        output.pipes = 0;
+        it = m_outputs.insert(make_pair(appId, output)).first;
+    }
+
+    // Instances of the same app share one buffer
+    Pipe pipe;
+    pipe.appId = appId;
+    pipe.sourceId = g_unix_fd_add(fds[0], (GIOCondition)(G_IO_IN | G_IO_HUP | G_IO_ERR), onRead, nullptr);
+    m_pipes[fds[0]] = pipe;
+    it->second.pipes++;
+    it->second.updatedTime = Time::getCurrentTime();
+    readerFd = fds[0];
+    return fds[1];
+}
+
+bool OutputCapture::getOutput(const string& appId, string& output)
+{
+    auto it = m_outputs.find(appId);
+    if (it == m_outputs.end())
+        return false;
+
+    drainAll(appId, it->second);
+    const vector<char>& buffer = it->second.buffer;
+    size_t start = (it->second.head + buffer.size() - it->second.size) % buffer.size();
+    output.clear();
+    output.reserve(it->second.size);
+    for (size_t i = 0; i < it->second.size; ++i)
+        output += buffer[(start + i) % buffer.size()];
+    return true;
+}
+
+bool OutputCapture::flush(const string& appId, string& path)
+{
+    string output;
+    if (!getOutput(appId, output))
+        return false;
+
+    // One file per app. Disk usage is bounded by buffer size.
+    string directory = "/var/log";
+    JValueUtil::getValue(SAMConf::getInstance().getNativeOutput(), "path", directory);
+    if (RuntimeInfo::getInstance().getUser().empty())
+        path = File::join(directory, appId + ".log");
+    else
+        path = File::join(directory, appId + "-" + RuntimeInfo::getInstance().getUser() + ".log");
+
+    if (!File::writeFileAtomically(path, output)) {
+        Logger::error(getClassName(), __FUNCTION__, appId, "Failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+bool OutputCapture::drain(int fd, Output& output)
+{
+    char buffer[4096];
+    bool isOpened = true;
+    for (int reads = 0; reads < MAX_READS_PER_DRAIN; ++reads) {
+        ssize_t size = read(fd, buffer, sizeof(buffer));
+        if (size > 0) {
+            append(output, buffer, size);
+            continue;
+        }
+        if (size < 0 && errno == EINTR)
+            continue;
+        // Pipe is closed when all processes of the instance exited
+        if (size == 0 || errno != EAGAIN)
+            isOpened = false;
+        break;
+    }
+    output.updatedTime = Time::getCurrentTime();
+    return isOpened;
+}
+
+void OutputCapture::drainAll(const string& appId, Output& output)
+{
+    for (auto it = m_pipes.begin(); it != m_pipes.end();) {
+        int fd = it->first;
+        ++it;
+        if (m_pipes[fd].appId != appId)
+            continue;
+        if (!drain(fd, output)) {
+            closePipe(fd);
+            output.pipes--;
+        }
+    }
+}
+
+void OutputCapture::closePipe(int fd)
+{
+    auto it = m_pipes.find(fd);
+    if (it == m_pipes.end())
+        return;
+    if (it->second.sourceId != 0)
+        g_source_remove(it->second.sourceId);
+    m_pipes.erase(it);
+    close(fd);
+}
+
+void OutputCapture::append(Output& output, const char* data, size_t size)
+{
+    vector<char>& buffer = output.buffer;
+    // Only the tail fits into the buffer
+    if (size > buffer.size()) {
+        data += size - buffer.size();
+        size = buffer.size();
+    }
+    for (size_t i = 0; i < size; ++i) {
+        buffer[output.head] = data[i];
+        output.head = (output.head + 1) % buffer.size();
+    }
+    output.size = min(output.size + size, buffer.size());
+}
+
+void OutputCapture::removeOldest()
+{
+    auto oldest = m_outputs.end();
+    for (auto it = m_outputs.begin(); it != m_outputs.end(); ++it) {
+        // Running app is not removed
+        if (it->second.pipes > 0)
+            continue;
+        if (oldest == m_outputs.end() || it->second.updatedTime < oldest->second.updatedTime)
+            oldest = it;
+    }
+    if (oldest != m_outputs.end())
+        m_outputs.erase(oldest);
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_OUTPUTCAPTURE_H_
+#define UTIL_OUTPUTCAPTURE_H_
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <glib.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+// Keeps recent stdout/stderr of native apps in memory.
+// Output is written to disk only on crash or on demand.
+class OutputCapture : public ISingleton<OutputCapture>,
+                      public IClassName {
+friend class ISingleton<OutputCapture> ;
+public:
+    virtual ~OutputCapture();
+
+    void finalize();
+
+    // Returns write end of pipe for child's stdout and stderr. -1 on failure.
+    // readerFd is the read end. Child keeps a copy so that writes never get EPIPE
+    // after SAM restarts. Output is dropped once nobody drains the pipe.
+    int open(const string& appId, int& readerFd);
+
+    bool getOutput(const string& appId, string& output);
+    bool flush(const string& appId, string& path);
+
+private:
+    struct Output {
+        vector<char> buffer;
+        size_t head;
+        size_t size;
+        int pipes;
+        long long updatedTime;
+    };
+
+    struct Pipe {
+        string appId;
+        guint sourceId;
+    };
+
+    // Bounds the time spent in one callback when the child writes faster than SAM reads
+    static const int MAX_READS_PER_DRAIN = 16;
+
+    static gboolean onRead(gint fd, GIOCondition condition, gpointer context);
+
+    OutputCapture();
+
+    // Returns false if the pipe is closed. Remaining data wakes up onRead again.
+    bool drain(int fd, Output& output);
+    void drainAll(const string& appId, Output& output);
+    void closePipe(int fd);
+    void append(Output& output, const char* data, size_t size);
+    void removeOldest();
+
+    // appId => output. Output of exited apps is kept until it is evicted.
+    map<string, Output> m_outputs;
+    // read end of pipe => app. Each instance has its own pipe.
+    map<int, Pipe> m_pipes;
+};
+
+#endif /* UTIL_OUTPUTCAPTURE_H_ */
@@ -0,0 +1,189 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "ProcessTracker.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib-unix.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#include "util/Logger.h"
+
+// Older libc doesn't have the syscall numbers
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+
+gboolean ProcessTracker::onEvent(gint fd, GIOCondition condition, gpointer context)
+{
+    struct epoll_event events[MAX_EVENTS];
+    int count = epoll_wait(fd, events, MAX_EVENTS, 0);
+    for (int i = 0; i < count; ++i) {
+        auto it = getInstance().m_pids.find(events[i].data.fd);
+        if (it == getInstance().m_pids.end())
+            continue;
+
+        pid_t pid = it->second;
+        int status = 0;
+        // Non-child process returns ECHILD. Status is not available for it.
+        if (waitpid(pid, &status, WNOHANG) == 0)
+            continue;
+        getInstance().onExit(pid, status);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void ProcessTracker::onChildWatch(GPid pid, gint status, gpointer context)
+{
+    g_spawn_close_pid(pid);
+    getInstance().onExit(pid, status);
+}
+
+ProcessTracker::ProcessTracker()
+    : m_epollFd(-1),
+      m_epollSourceId(0)
+{
+    setClassName("ProcessTracker");
+}
+
+ProcessTracker::~ProcessTracker()
+{
+}
+
+void ProcessTracker::initialize()
+{
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0) {
+        Logger::error(getClassName(), __FUNCTION__, strerror(errno));
+        return;
+    }
+    m_epollSourceId = g_unix_fd_add(m_epollFd, G_IO_IN, onEvent, nullptr);
+}
+
+void ProcessTracker::finalize()
+{
+    for (auto it = m_processes.begin(); it != m_processes.end(); ++it) {
+        if (it->second.pidfd >= 0)
+            close(it->second.pidfd);
+        if (it->second.sourceId != 0)
+            g_source_remove(it->second.sourceId);
+    }
+    m_processes.clear();
+    m_pids.clear();
+
+    if (m_epollSourceId != 0) {
+        g_source_remove(m_epollSourceId);
+        m_epollSourceId = 0;
+    }
+    if (m_epollFd >= 0) {
+        close(m_epollFd);
+        m_epollFd = -1;
+    }
+}
+
+bool ProcessTracker::watch(pid_t pid, bool isChild, ProcessExitCallback callback)
+{
+    if (pid <= 0 || isWatched(pid))
+        return false;
+
+    Process process;
+    process.pidfd = -1;
+    process.sourceId = 0;
+    process.isChild = isChild;
+    process.callback = callback;
+
+    if (m_epollFd >= 0)
+        process.pidfd = syscall(SYS_pidfd_open, pid, 0);
+
+    if (process.pidfd >= 0) {
+        fcntl(process.pidfd, F_SETFD, FD_CLOEXEC);
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = process.pidfd;
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, process.pidfd, &event) == 0) {
+            m_pids[process.pidfd] = pid;
+            m_processes[pid] = process;
+            return true;
+        }
+        close(process.pidfd);
+        process.pidfd = -1;
+    }
+
+    // pidfd is supported since linux 5.3
+    if (!isChild) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Cannot watch process(%d): %s", pid, strerror(errno)));
+        return false;
+    }
+    process.sourceId = g_child_watch_add(pid, onChildWatch, nullptr);
+    m_processes[pid] = process;
+    return true;
+}
+
+bool ProcessTracker::sendSignal(pid_t pid, int signal)
+{
+    auto it = m_processes.find(pid);
+    if (it == m_processes.end()) {
+        Logger::warning(getClassName(), __FUNCTION__, Logger::format("Process(%d) is not watched", pid));
+        errno = ESRCH;
+        return false;
+    }
+
+    // Signal the leader through pidfd first. It never hits recycled pid.
+    if (it->second.pidfd >= 0 && syscall(SYS_pidfd_send_signal, it->second.pidfd, signal, nullptr, 0) != 0) {
+        if (errno == ESRCH)
+            return false;
+    }
+
+    // Child leader is not reaped yet. So its process group id is still owned by the app.
+    // Others are reaped by their parent immediately. Then the group id can be reused.
+    if (!it->second.isChild && it->second.pidfd >= 0) {
+        struct pollfd pfd = { it->second.pidfd, POLLIN, 0 };
+        if (poll(&pfd, 1, 0) > 0)
+            return true;
+    }
+    if (killpg(pid, signal) != 0 && errno != ESRCH)
+        return false;
+    return true;
+}
+
+void ProcessTracker::onExit(pid_t pid, int status)
+{
+    auto it = m_processes.find(pid);
+    if (it == m_processes.end())
+        return;
+
+    Process process = it->second;
+    m_processes.erase(it);
+    if (process.pidfd >= 0) {
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, process.pidfd, nullptr);
+        m_pids.erase(process.pidfd);
+        close(process.pidfd);
+    }
+    if (process.callback)
+        process.callback(pid, status);
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_PROCESSTRACKER_H_
+#define UTIL_PROCESSTRACKER_H_
+
+#include <iostream>
+#include <unordered_map>
+#include <boost/function.hpp>
+#include <glib.h>
+#include <sys/types.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+typedef boost::function<void(pid_t pid, int status)> ProcessExitCallback;
+
+// Watches processes with pidfd. All pidfds are polled by one epoll fd in main loop.
+// Tracked child is reaped only here. Its pid cannot be reused until callback is called.
+class ProcessTracker : public ISingleton<ProcessTracker>,
+                       public IClassName {
+friend class ISingleton<ProcessTracker> ;
+public:
+    virtual ~ProcessTracker();
+
+    void initialize();
+    void finalize();
+
+    // Non-child process can be watched only with pidfd
+    bool watch(pid_t pid, bool isChild, ProcessExitCallback callback);
+    bool isWatched(pid_t pid) const
+    {
+        return m_processes.find(pid) != m_processes.end();
+    }
+
+    // Signal is sent to process group. It fails if the process already exited.
+    bool sendSignal(pid_t pid, int signal);
+
+private:
+    struct Process {
+        int pidfd;
+        guint sourceId;
+        bool isChild;
+        ProcessExitCallback callback;
+    };
+
+    static const int MAX_EVENTS = 64;
+
+    static gboolean onEvent(gint fd, GIOCondition condition, gpointer context);
+    static void onChildWatch(GPid pid, gint status, gpointer context);
+
+    ProcessTracker();
+
+    void onExit(pid_t pid, int status);
+
+    int m_epollFd;
+    guint m_epollSourceId;
+
+    unordered_map<pid_t, Process> m_processes;
+    unordered_map<int, pid_t> m_pids;
+};
+
+#endif /* UTIL_PROCESSTRACKER_H_ */
@@ -0,0 +1,109 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "TimerWheel.h"
+
+gboolean TimerWheel::onTick(gpointer context)
+{
+    TimerWheel::getInstance().tick();
+    if (TimerWheel::getInstance().m_timers.empty()) {
+        TimerWheel::getInstance().m_sourceId = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+TimerWheel::TimerWheel()
+    : m_slots(SLOTS),
+      m_current(0),
+      m_lastId(0),
+      m_sourceId(0)
+{
+    setClassName("TimerWheel");
+}
+
+TimerWheel::~TimerWheel()
+{
+    if (m_sourceId != 0)
+        g_source_remove(m_sourceId);
+}
+
+guint TimerWheel::add(guint timeout, TimerCallback callback)
+{
+    if (!callback)
+        return 0;
+
+    // Next tick can come any time within TICK. One more tick keeps deadline from being early.
+    guint ticks = (timeout + TICK - 1) / TICK + 1;
+
+    // 0 is reserved for 'no timer'
+    if (++m_lastId == 0)
+        ++m_lastId;
+
+    Timer timer;
+    timer.id = m_lastId;
+    timer.rounds = (ticks - 1) / SLOTS;
+    timer.callback = callback;
+
+    guint slot = (m_current + ticks) % SLOTS;
+    m_slots[slot].push_front(timer);
+    m_timers[timer.id] = make_pair(slot, m_slots[slot].begin());
+
+    if (m_sourceId == 0)
+        m_sourceId = g_timeout_add(TICK, onTick, nullptr);
+    return timer.id;
+}
+
+void TimerWheel::remove(guint timerId)
+{
+    auto it = m_timers.find(timerId);
+    if (it == m_timers.end())
+        return;
+    // Expired timer is owned by tick(). Dropping its id is enough to cancel it.
+    if (it->second.first != EXPIRED)
+        m_slots[it->second.first].erase(it->second.second);
+    m_timers.erase(it);
+}
+
+void TimerWheel::tick()
+{
+    m_current = (m_current + 1) % SLOTS;
+
+    // Expired timers are detached first. Callbacks can add or remove timers.
+    list<Timer> expired;
+    list<Timer>& slot = m_slots[m_current];
+    for (auto it = slot.begin(); it != slot.end();) {
+        if (it->rounds > 0) {
+            it->rounds--;
+            ++it;
+            continue;
+        }
+        m_timers[it->id].first = EXPIRED;
+        auto next = std::next(it);
+        expired.splice(expired.end(), slot, it);
+        it = next;
+    }
+
+    // Previous callback can cancel timers which are expired in same tick
+    for (auto it = expired.begin(); it != expired.end(); ++it) {
+        auto timer = m_timers.find(it->id);
+        if (timer == m_timers.end())
+            continue;
+        m_timers.erase(timer);
+        it->callback();
+    }
+}
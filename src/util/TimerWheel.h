@@ -0,0 +1,78 @@
+// Copyright (c) 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef UTIL_TIMERWHEEL_H_
+#define UTIL_TIMERWHEEL_H_
+
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <boost/function.hpp>
+#include <glib.h>
+
+#include "interface/IClassName.h"
+#include "interface/ISingleton.h"
+
+using namespace std;
+
+typedef boost::function<void()> TimerCallback;
+
+// Hashed timer wheel for lifecycle deadlines.
+// All timers share one GSource which runs only while any timer is armed.
+class TimerWheel : public ISingleton<TimerWheel>,
+                   public IClassName {
+friend class ISingleton<TimerWheel> ;
+public:
+    virtual ~TimerWheel();
+
+    // Callback is called at least timeout later and at most 2 * TICK after that. Returns 0 on failure.
+    guint add(guint timeout, TimerCallback callback);
+    void remove(guint timerId);
+
+    size_t size() const
+    {
+        return m_timers.size();
+    }
+
+private:
+    static const guint TICK = 100; // milliseconds
+    static const guint SLOTS = 256;
+    // Slot index of timers which are detached by tick() but not called yet
+    static const guint EXPIRED = SLOTS;
+
+    struct Timer {
+        guint id;
+        guint rounds;
+        TimerCallback callback;
+    };
+
+    static gboolean onTick(gpointer context);
+
+    TimerWheel();
+
+    void tick();
+
+    vector< list<Timer> > m_slots;
+    unordered_map<guint, pair<guint, list<Timer>::iterator> > m_timers;
+
+    guint m_current;
+    guint m_lastId;
+    guint m_sourceId;
+};
+
+#endif /* UTIL_TIMERWHEEL_H_ */